@@ -0,0 +1,158 @@
+#include "../include/stc/monotonic_arena.h"
+#include "../include/stc/pool_allocator.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+#include <random>
+
+// std::allocator counting the calls reaching malloc.
+template <typename T>
+struct CountingAllocator : std::allocator<T>
+{
+	using value_type = T;
+
+	inline static size_t allocations = 0;
+
+	CountingAllocator() = default;
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	T* allocate(size_t count)
+	{
+		++allocations;
+		return std::allocator<T>::allocate(count);
+	}
+
+	template <typename U>
+	struct rebind { using other = CountingAllocator<U>; };
+};
+
+void PrintSBA(const stc::swap_back_array<int32, stc::arena_allocator<int32>>& sba)
+{
+	for (int32 value : sba)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	stc::monotonic_arena arena;
+	{
+		// The array draws its memory from the arena
+		stc::swap_back_array<int32, stc::arena_allocator<int32>> data({0, 1, 2, 3, 4, 5}, arena);
+		data.erase_swap(1);
+		PrintSBA(data);
+		std::cout << "arena blocks: " << arena.upstream_allocations() << ", capacity: " << arena.capacity() << " bytes" << std::endl;
+	}
+	// All the memory is reclaimed at once, at the end of the frame
+	arena.reset();
+
+	stc::pool_resource pool;
+	{
+		// Freed buffers are recycled by later arrays of the same size class
+		stc::swap_back_array<int32, stc::pool_allocator<int32>> first({0, 1, 2}, pool);
+		const int32* buffer = first.data();
+		first = {};
+		first.shrink_to_fit();
+
+		stc::swap_back_array<int32, stc::pool_allocator<int32>> second({3, 4, 5}, pool);
+		std::cout << std::boolalpha << "buffer reused: " << (second.data() == buffer) << std::endl;
+	}
+	pool.reset();
+
+
+	std::cout << "\nSpeed comparison:\n\n";
+
+	// Each frame creates, fills, trims and destroys many short-lived arrays of random sizes.
+	constexpr size_t arrays_per_frame = 1'000;
+	constexpr size_t frames = 200;
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<size_t> size_distribution(1, 256);
+	std::vector<size_t> sizes(arrays_per_frame);
+	for (auto& size : sizes)
+		size = size_distribution(rng);
+
+	auto fill = [&](auto& sba, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+			sba.push_back(uint32(i));
+		sba.erase_swap_if([](uint32 value) { return value % 3 == 0; });
+		benchmark::do_not_optimize(sba.data());
+	};
+
+	auto frame_std = [&]()
+	{
+		for (size_t size : sizes)
+		{
+			stc::swap_back_array<uint32, CountingAllocator<uint32>> sba;
+			fill(sba, size);
+		}
+	};
+
+	stc::monotonic_arena frame_arena;
+	auto frame_arena_alloc = [&]()
+	{
+		for (size_t size : sizes)
+		{
+			stc::swap_back_array<uint32, stc::arena_allocator<uint32>> sba(frame_arena);
+			fill(sba, size);
+		}
+		frame_arena.reset();
+	};
+
+	stc::pool_resource frame_pool;
+	auto frame_pool_alloc = [&]()
+	{
+		for (size_t size : sizes)
+		{
+			stc::swap_back_array<uint32, stc::pool_allocator<uint32>> sba(frame_pool);
+			fill(sba, size);
+		}
+		frame_pool.reset();
+	};
+
+	// Arrays living for the whole frame, only released at its end.
+	std::vector<stc::swap_back_array<uint32, CountingAllocator<uint32>>> kept_std;
+	auto frame_kept_std = [&]()
+	{
+		for (size_t size : sizes)
+			fill(kept_std.emplace_back(), size);
+		kept_std.clear();
+	};
+
+	using arena_sba = stc::swap_back_array<uint32, stc::arena_allocator<uint32>>;
+	std::vector<arena_sba> kept_arena;
+	auto frame_kept_arena = [&]()
+	{
+		for (size_t size : sizes)
+			fill(kept_arena.emplace_back(frame_arena), size);
+		kept_arena.clear();
+		frame_arena.reset();
+	};
+
+	kept_std.reserve(arrays_per_frame);
+	kept_arena.reserve(arrays_per_frame);
+
+	CountingAllocator<uint32>::allocations = 0;
+	benchmark(frames)
+		.add("std::allocator", frame_std)
+		.add("arena_allocator", frame_arena_alloc)
+		.add("pool_allocator", frame_pool_alloc)
+		.print_results();
+	auto std_allocations = CountingAllocator<uint32>::allocations;
+
+	std::cout << "\nUpstream allocations per frame:\n"
+		<< "std::allocator  " << double(std_allocations) / frames << '\n'
+		<< "arena_allocator " << double(frame_arena.upstream_allocations()) / frames << '\n'
+		<< "pool_allocator  " << double(frame_pool.arena().upstream_allocations()) / frames << '\n';
+
+	std::cout << "\nArrays kept until the end of the frame:\n\n";
+	benchmark(frames)
+		.add("std::allocator", frame_kept_std)
+		.add("arena_allocator", frame_kept_arena)
+		.print_results();
+}
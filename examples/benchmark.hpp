@@ -57,6 +57,22 @@ public:
 		return std::numeric_limits<size_t>::max();
 	}
 
+	/**
+	 * Prevents the compiler from optimizing away the computation of a value.
+	 *
+	 * @param value The value that must be considered as used.
+	 */
+	template <typename T>
+	static void do_not_optimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
 public:
 
 	/**
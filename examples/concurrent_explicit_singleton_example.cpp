@@ -0,0 +1,95 @@
+#include "../include/stc/concurrent_explicit_singleton.h"
+#include "../include/stc/explicit_singleton.h"
+#include "../include/stc/lazy_singleton.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+struct Config
+{
+	Config() = default;
+	Config(uint32 frame_rate) : frame_rate(frame_rate) {}
+
+	uint32 frame_rate = 60;
+};
+
+// Explicit singletons of a plain type, without CRTP.
+using ConcurrentConfig = stc::concurrent_explicit_singleton<Config>;
+using ExplicitConfig = stc::explicit_singleton<Config>;
+
+class LazyConfig : public stc::lazy_singleton<LazyConfig>, public Config
+{
+	friend lazy_singleton;
+};
+
+// The usual alternatives: every access takes a lock.
+Config mutex_config;
+std::mutex config_mutex;
+std::shared_mutex config_shared_mutex;
+
+uint32 ReadWithMutex()
+{
+	std::lock_guard lock(config_mutex);
+	return mutex_config.frame_rate;
+}
+
+uint32 ReadWithSharedMutex()
+{
+	std::shared_lock lock(config_shared_mutex);
+	return mutex_config.frame_rate;
+}
+
+// Runs read on thread_count threads, and returns the total millions of reads per second.
+double MillionReadsPerSecond(unsigned thread_count, auto read)
+{
+	constexpr size_t reads_per_thread = 2'000'000;
+	std::vector<std::thread> threads;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			// the memory clobber keeps every read in the loop, state load included
+			for (size_t i = 0; i < reads_per_thread; ++i)
+				benchmark::do_not_optimize(read());
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return thread_count * reads_per_thread / elapsed.count() / 1e6;
+}
+
+int main()
+{
+	// Any thread may construct, replace or destruct the instance, one at a time
+	std::thread loader([]() { ConcurrentConfig::construct_instance(144u); });
+	loader.join();
+
+	// Readers only load the state, and get nullptr while there is no instance
+	if (Config* config = ConcurrentConfig::try_instance())
+		std::cout << "frame rate: " << config->frame_rate << std::endl;
+	ExplicitConfig::construct_instance(144u);
+
+	std::cout << "\nConcurrent reads, millions per second:\n\n" << std::setw(8) << "Threads"
+		<< std::setw(14) << "concurrent" << std::setw(12) << "explicit" << std::setw(10) << "lazy"
+		<< std::setw(10) << "mutex" << std::setw(16) << "shared_mutex" << '\n';
+
+	for (unsigned thread_count = 1; thread_count <= 64; thread_count *= 2)
+	{
+		std::cout << std::setw(8) << thread_count << std::fixed << std::setprecision(0)
+			<< std::setw(14) << MillionReadsPerSecond(thread_count, []() { return ConcurrentConfig::instance().frame_rate; })
+			<< std::setw(12) << MillionReadsPerSecond(thread_count, []() { return ExplicitConfig::instance().frame_rate; })
+			<< std::setw(10) << MillionReadsPerSecond(thread_count, []() { return LazyConfig::instance().frame_rate; })
+			<< std::setw(10) << MillionReadsPerSecond(thread_count, ReadWithMutex)
+			<< std::setw(16) << MillionReadsPerSecond(thread_count, ReadWithSharedMutex) << '\n';
+	}
+
+	ConcurrentConfig::destruct_instance();
+}
@@ -0,0 +1,142 @@
+#include "../include/stc/concurrent_swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+struct Entity
+{
+	uint32 id = 0;
+	float position[3]{};
+};
+
+void PrintCSBA(const stc::concurrent_swap_back_array<uint32>& csba)
+{
+	// Compatible with range-based for loop, at a sync point.
+	for (uint32 value : csba)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+}
+
+// Runs job(thread_index) on thread_count threads and waits for all of them.
+template <typename Job>
+void RunThreads(size_t thread_count, Job job)
+{
+	std::vector<std::jthread> threads;
+	threads.reserve(thread_count);
+	for (size_t t = 0; t < thread_count; ++t)
+		threads.emplace_back(job, t);
+}
+
+int main()
+{
+	// The capacity is reserved up front, appends fail once it is reached
+	stc::concurrent_swap_back_array<uint32> data(16);
+
+	// Several threads append at the same time without locking
+	RunThreads(4, [&](size_t t)
+	{
+		for (uint32 i = 0; i < 4; ++i)
+			data.try_push_back(uint32(t * 4 + i));
+	});
+	std::cout << "full: " << std::boolalpha << data.full() << ", rejected: " << (data.try_push_back(16) == nullptr) << std::endl;
+	PrintCSBA(data);
+
+	// Removals are queued by each thread...
+	RunThreads(2, [&](size_t t)
+	{
+		for (size_t i = t; i < data.size(); i += 4)
+			data.erase_swap(i);
+	});
+	std::cout << data.pending_erase_count() << " pending removals" << std::endl;
+
+	// ...and applied by the owner at a sync point
+	data.flush();
+	PrintCSBA(data);
+
+
+	std::cout << "\nSpeed comparison:\n";
+
+	// Each iteration, the threads share the production of entity_count entities.
+	// The cost of starting the threads is shared by both contenders.
+	constexpr size_t entity_count = 1'000'000;
+
+	stc::concurrent_swap_back_array<Entity> concurrent_entities(entity_count);
+	stc::swap_back_array<Entity> locked_entities;
+	locked_entities.reserve(entity_count);
+	std::mutex entities_mutex;
+
+	for (size_t thread_count = 1; thread_count <= 32; thread_count *= 2)
+	{
+		size_t per_thread = entity_count / thread_count;
+
+		auto append_concurrent = [&]()
+		{
+			concurrent_entities.clear();
+			RunThreads(thread_count, [&](size_t t)
+			{
+				for (size_t i = 0; i < per_thread; ++i)
+					concurrent_entities.try_emplace_back(Entity{uint32(t * per_thread + i)});
+			});
+			benchmark::do_not_optimize(concurrent_entities.size());
+		};
+
+		auto append_mutex = [&]()
+		{
+			locked_entities.clear();
+			RunThreads(thread_count, [&](size_t t)
+			{
+				for (size_t i = 0; i < per_thread; ++i)
+				{
+					std::scoped_lock lock(entities_mutex);
+					locked_entities.emplace_back(Entity{uint32(t * per_thread + i)});
+				}
+			});
+			benchmark::do_not_optimize(locked_entities.size());
+		};
+
+		// Every other entity is removed by the thread that produced it, then the removals are applied.
+		auto append_erase_concurrent = [&]()
+		{
+			concurrent_entities.clear();
+			RunThreads(thread_count, [&](size_t t)
+			{
+				for (size_t i = 0; i < per_thread; ++i)
+				{
+					Entity* entity = concurrent_entities.try_emplace_back(Entity{uint32(t * per_thread + i)});
+					if (i % 2 == 0)
+						concurrent_entities.erase_swap(size_t(entity - concurrent_entities.data()));
+				}
+			});
+			concurrent_entities.flush();
+		};
+
+		auto append_erase_mutex = [&]()
+		{
+			locked_entities.clear();
+			std::vector<size_t> indices;
+			RunThreads(thread_count, [&](size_t t)
+			{
+				for (size_t i = 0; i < per_thread; ++i)
+				{
+					std::scoped_lock lock(entities_mutex);
+					locked_entities.emplace_back(Entity{uint32(t * per_thread + i)});
+					if (i % 2 == 0)
+						indices.push_back(locked_entities.size() - 1);
+				}
+			});
+			locked_entities.erase_swap_indices(indices);
+		};
+
+		std::cout << '\n' << thread_count << " thread(s), " << entity_count << " appends:\n\n";
+		benchmark(10)
+			.add("Atomic cursor", append_concurrent)
+			.add("Mutex", append_mutex)
+			.add("Atomic cursor + erase queues", append_erase_concurrent)
+			.add("Mutex + erase batch", append_erase_mutex)
+			.print_results();
+	}
+}
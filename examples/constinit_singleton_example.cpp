@@ -0,0 +1,54 @@
+#include "../include/stc/constinit_singleton.h"
+#include "../include/stc/eager_singleton.h"
+#include "../include/stc/explicit_singleton.h"
+#include "../include/stc/lazy_singleton.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+
+class MyConstinitSingleton : public stc::constinit_singleton<MyConstinitSingleton>
+//                                                           ^ This is CRTP (Curiously Recurring Template Pattern)
+{
+	// The line below allows the construction of MyConstinitSingleton even if the constructor is private.
+	friend constinit_singleton;
+
+	// The constructor must be constexpr: the instance is initialized at compile time.
+	constexpr MyConstinitSingleton() = default;
+
+	int i = 0;
+
+public:
+
+	void Print() { std::cout << "i = " << i++ << std::endl; }
+};
+
+// Dynamic initialization of another static object: the instance is already usable, whatever the order.
+const bool used_during_static_init = (MyConstinitSingleton::instance().Print(), true);
+
+// The same constant-initializable type behind each kind of singleton.
+struct Counter
+{
+	constexpr Counter() = default;
+
+	uint64 value = 0;
+};
+
+int main()
+{
+	std::cout << "Example start!" << std::endl;
+	MyConstinitSingleton::instance().Print();
+
+	stc::explicit_singleton<Counter>::construct_instance();
+
+	// The memory clobber reloads everything instance() reads at every call, e.g. the guard of lazy_singleton
+	constexpr size_t calls = 1'000'000'000;
+	std::cout << "\n" << calls << " calls to instance():\n\n";
+	benchmark(calls)
+		.add("lazy_singleton", []() { benchmark::do_not_optimize(&stc::lazy_singleton<Counter>::instance()); })
+		.add("eager_singleton", []() { benchmark::do_not_optimize(&stc::eager_singleton<Counter>::instance()); })
+		.add("explicit_singleton", []() { benchmark::do_not_optimize(&stc::explicit_singleton<Counter>::instance()); })
+		.add("constinit_singleton", []() { benchmark::do_not_optimize(&stc::constinit_singleton<Counter>::instance()); })
+		.print_results();
+
+	stc::explicit_singleton<Counter>::destruct_instance();
+}
@@ -0,0 +1,135 @@
+#include "../include/stc/deferred_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+
+struct Entity
+{
+	float position[3]{};
+	float velocity[3]{1, 0, 0};
+	uint32 id = 0;
+	uint32 health = 100;
+};
+
+// Roughly 2% of the entities die every frame.
+bool Dies(const Entity& e, uint32 frame)
+{
+	return (e.id * 2654435761u + frame) % 50 == 0;
+}
+
+void Move(Entity& e)
+{
+	for (int axis = 0; axis < 3; ++axis)
+		e.position[axis] += e.velocity[axis] * 0.016f;
+}
+
+int main()
+{
+	stc::deferred_swap_back_array<int32> data;
+	for (int32 i = 0; i < 10; ++i)
+		data.push_back(i);
+
+	// Erasing while iterating, even the elements ahead, keeps the iteration valid
+	for (auto it = data.begin(); it != data.end(); ++it)
+	{
+		if (*it % 4 == 0)
+			data.erase_deferred(it.index() + 1);
+	}
+	for (int32 value : data)
+		std::cout << value << " ";
+	std::cout << std::endl;
+
+	// The erased slots are removed in one pass, with the usual swap back
+	data.compact();
+	for (int32 value : data)
+		std::cout << value << " ";
+	std::cout << std::endl;
+
+
+	constexpr size_t count = 1'000'000;
+	constexpr size_t frames = 20;
+
+	stc::swap_back_array<Entity> immediate;
+	stc::deferred_swap_back_array<Entity> deferred;
+	immediate.reserve(count);
+	deferred.reserve(count * 2);
+	for (uint32 i = 0; i < count; ++i)
+	{
+		immediate.push_back({.id = i});
+		deferred.push_back({.id = i});
+	}
+
+	// Every frame moves the entities, removes the dead ones, and spawns as many.
+	uint32 next_id = count;
+	auto run_immediate = [&](size_t frame)
+	{
+		size_t dead = 0;
+		for (auto it = immediate.begin(); it != immediate.end();)
+		{
+			if (Dies(*it, uint32(frame)))
+			{
+				it = immediate.erase_swap(it);
+				++dead;
+			}
+			else
+			{
+				Move(*it);
+				++it;
+			}
+		}
+		for (; dead > 0; --dead)
+			immediate.push_back({.id = next_id++});
+	};
+
+	auto run_deferred = [&](size_t frame, size_t compact_period)
+	{
+		size_t dead = 0;
+		for (auto it = deferred.begin(); it != deferred.end(); ++it)
+		{
+			if (Dies(*it, uint32(frame)))
+			{
+				deferred.erase_deferred(it);
+				++dead;
+			}
+			else
+			{
+				Move(*it);
+			}
+		}
+		for (; dead > 0; --dead)
+			deferred.push_back({.id = next_id++});
+		if (frame % compact_period == compact_period - 1)
+			deferred.compact();
+	};
+
+	std::cout << "\n" << frames << " frames of " << count << " entities, 2% removed and respawned per frame:\n\n";
+	benchmark(frames)
+		.add("erase_swap while iterating", [&](size_t frame) { run_immediate(frame); })
+		.add("erase_deferred, compact every frame", [&](size_t frame) { run_deferred(frame, 1); })
+		.add("erase_deferred, compact every 8 frames", [&](size_t frame) { run_deferred(frame, 8); })
+		.print_results();
+	deferred.compact();
+
+	// The cost of skipping erased slots during iteration.
+	auto iterate = [](auto& entities)
+	{
+		for (Entity& e : entities)
+			Move(e);
+		benchmark::do_not_optimize(entities);
+	};
+
+	stc::deferred_swap_back_array<Entity> pending;
+	pending.reserve(count);
+	for (uint32 i = 0; i < count; ++i)
+		pending.push_back({.id = i});
+	for (size_t i = 0; i < count; i += 10)
+		pending.erase_deferred(i);
+
+	std::cout << "\nIteration over " << count << " entities:\n\n";
+	benchmark(100)
+		.add("swap_back_array", [&]() { iterate(immediate); })
+		.add("deferred, nothing erased", [&]() { iterate(deferred); })
+		.add("deferred, 10% erased", [&]() { iterate(pending); })
+		.print_results();
+}
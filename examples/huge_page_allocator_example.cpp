@@ -0,0 +1,228 @@
+#include "../include/stc/huge_page_allocator.h"
+#include "../include/stc/small_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Counts the data TLB misses of the calling thread, when the kernel allows it.
+class DtlbCounter
+{
+public:
+
+	DtlbCounter()
+	{
+#if defined(__linux__)
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd_ = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+	}
+
+	~DtlbCounter()
+	{
+#if defined(__linux__)
+		if (fd_ >= 0)
+			close(fd_);
+#endif
+	}
+
+	bool available() const { return fd_ >= 0; }
+
+	void start()
+	{
+#if defined(__linux__)
+		if (fd_ >= 0)
+		{
+			ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	uint64 stop()
+	{
+		uint64 count = 0;
+#if defined(__linux__)
+		if (fd_ >= 0)
+		{
+			ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(fd_, &count, sizeof(count)) != sizeof(count))
+				count = 0;
+		}
+#endif
+		return count;
+	}
+
+private:
+
+	int fd_ = -1;
+};
+
+// Returns the amount of anonymous memory backed by huge pages in the process, as reported by Linux.
+std::string HugePagesInUse()
+{
+	std::ifstream smaps("/proc/self/smaps_rollup");
+	std::string line, result;
+	while (std::getline(smaps, line))
+	{
+		if (line.starts_with("AnonHugePages") || line.starts_with("Private_Hugetlb"))
+			result += line + "  ";
+	}
+	return result.empty() ? "unknown" : result;
+}
+
+// Runs passes of accesses over the array, and prints the throughput and the dTLB misses per access.
+template <typename Array>
+void Measure(std::string_view name, std::string_view access, Array& values, size_t accesses_per_pass, auto pass)
+{
+	constexpr int passes = 3;
+	DtlbCounter counter;
+	uint64 sum = 0;
+
+	counter.start();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < passes; ++i)
+		sum += pass(values);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	uint64 misses = counter.stop();
+	benchmark::do_not_optimize(sum);
+
+	double accesses = double(accesses_per_pass) * passes;
+	std::cout << std::left << std::setw(24) << name << std::setw(12) << access << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << accesses / elapsed.count() / 1e6 << " M/s";
+	if (counter.available())
+		std::cout << std::setw(14) << std::setprecision(4) << misses / accesses << " misses/access";
+	else
+		std::cout << "      dTLB counter unavailable";
+	std::cout << '\n';
+}
+
+template <typename Array>
+void Run(std::string_view name, size_t size)
+{
+	Array values;
+	values.resize(size);
+	for (size_t i = 0; i < size; ++i)
+		values[i] = i;
+
+	auto sequential = [](Array& v)
+	{
+		uint64 sum = 0;
+		for (uint64 value : v)
+			sum += value;
+		return sum;
+	};
+
+	// Scattered accesses: the worst case for the TLB, e.g. a gather through an index array.
+	size_t random_accesses = size / 8;
+	auto random = [random_accesses](Array& v)
+	{
+		uint64 sum = 0;
+		uint64 mask = v.size() - 1;
+		uint64 index = 0;
+		for (size_t i = 0; i < random_accesses; ++i)
+		{
+			index = (index * 6364136223846793005ull + 1442695040888963407ull) & mask;
+			sum += v[index];
+		}
+		return sum;
+	};
+
+	Measure(name, "sequential", values, size, sequential);
+	Measure(name, "random", values, random_accesses, random);
+	std::cout << "    " << HugePagesInUse() << '\n';
+}
+
+// Grows an array to size elements, one emplace_back at a time, then doubles it with reserve.
+// Runs in a child process on Linux, so that the peak RSS is the one of the growth alone.
+template <typename Array>
+void MeasureGrowth(std::string_view name, size_t size)
+{
+	auto run = [&]()
+	{
+		Array values;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < size; ++i)
+			values.emplace_back(i);
+		std::chrono::duration<double> emplace_time = std::chrono::steady_clock::now() - start;
+
+		// exactly full, so that reserve moves every element
+		values.shrink_to_fit();
+		start = std::chrono::steady_clock::now();
+		values.reserve(size * 2);
+		std::chrono::duration<double> reserve_time = std::chrono::steady_clock::now() - start;
+		benchmark::do_not_optimize(values.data());
+
+		std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << emplace_time.count() * 1e3 << " ms" << std::setw(12) << reserve_time.count() * 1e3 << " ms";
+#if defined(__linux__)
+		rusage usage{};
+		getrusage(RUSAGE_SELF, &usage);
+		std::cout << std::setw(12) << usage.ru_maxrss / 1024 << " MiB";
+#endif
+		std::cout << std::endl;
+	};
+
+#if defined(__linux__)
+	std::cout.flush();
+	if (pid_t child = fork(); child == 0)
+	{
+		run();
+		_exit(0);
+	}
+	else if (child > 0)
+	{
+		waitpid(child, nullptr, 0);
+		return;
+	}
+#endif
+	run();
+}
+
+int main(int argc, char** argv)
+{
+	// Huge pages are transparent to the container.
+	stc::swap_back_array<int32, stc::huge_page_allocator<int32>> data = {0, 1, 2, 3, 4, 5};
+	data.erase_swap(1);
+	for (int32 value : data)
+		std::cout << value << " ";
+	std::cout << '\n';
+
+
+	// Size in MiB of the arrays, a power of two. Several GiB show the largest difference.
+	size_t mebibytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+	size_t size = mebibytes * 1024 * 1024 / sizeof(uint64);
+
+	std::cout << "\nIteration over " << mebibytes << " MiB:\n\n";
+	Run<stc::swap_back_array<uint64>>("std::allocator", size);
+	Run<stc::swap_back_array<uint64, stc::huge_page_allocator<uint64>>>("huge_page_allocator", size);
+
+	std::cout << "\nExplicit huge pages " << (stc::huge_page_resource::explicit_huge_pages_available() ? "used" : "unavailable, fell back to transparent huge pages") << '\n';
+
+	std::cout << "\nGrowth to " << mebibytes << " MiB:\n\n"
+		<< std::left << std::setw(40) << "Container" << std::right << std::setw(15) << "emplace_back" << std::setw(15) << "reserve x2" << std::setw(16) << "peak RSS" << '\n';
+	MeasureGrowth<stc::swap_back_array<uint64>>("swap_back_array", size);
+	MeasureGrowth<stc::swap_back_array<uint64, stc::huge_page_allocator<uint64>>>("swap_back_array, huge pages", size);
+	MeasureGrowth<stc::small_swap_back_array<uint64, 16>>("small_swap_back_array", size);
+	MeasureGrowth<stc::small_swap_back_array<uint64, 16, stc::huge_page_allocator<uint64>>>("small_swap_back_array, mremap growth", size);
+}
@@ -0,0 +1,139 @@
+#include "../include/stc/mapped_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+struct Entity
+{
+	uint32 id;
+	uint32 archetype;
+	float position[3];
+	float health;
+};
+
+// Drops the file from the page cache, so that the next open reads it from disk.
+void EvictFromPageCache(const std::filesystem::path& path)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+	fdatasync(fd);
+	posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	close(fd);
+}
+
+// Parses one "id,archetype,x,y,z,health" line.
+Entity ParseLine(const std::string& line)
+{
+	Entity e{};
+	const char* it = line.data();
+	const char* end = line.data() + line.size();
+	it = std::from_chars(it, end, e.id).ptr + 1;
+	it = std::from_chars(it, end, e.archetype).ptr + 1;
+	for (float& coordinate : e.position)
+		it = std::from_chars(it, end, coordinate).ptr + 1;
+	std::from_chars(it, end, e.health);
+	return e;
+}
+
+// Opens the table, then reads every element once, and prints both times.
+void PrintLoad(std::string_view name, const std::filesystem::path& path, auto load)
+{
+	EvictFromPageCache(path);
+
+	auto start = std::chrono::steady_clock::now();
+	auto table = load();
+	std::chrono::duration<double, std::milli> open_time = std::chrono::steady_clock::now() - start;
+
+	float total_health = 0;
+	for (const Entity& e : table)
+		total_health += e.health;
+	std::chrono::duration<double, std::milli> total_time = std::chrono::steady_clock::now() - start;
+	benchmark::do_not_optimize(total_health);
+
+	std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(12) << open_time.count() << " ms" << std::setw(12) << total_time.count() << " ms\n";
+}
+
+int main()
+{
+	auto directory = std::filesystem::temp_directory_path();
+	auto table_path = directory / "stc_entities.table";
+	auto dump_path = directory / "stc_entities.csv";
+	auto binary_path = directory / "stc_entities.bin";
+	std::filesystem::remove(table_path);
+
+	{
+		// The container lives in the file, and survives the process
+		stc::mapped_swap_back_array<Entity> entities(table_path);
+		entities.push_back({0, 1, {0, 0, 0}, 100});
+		entities.push_back({1, 2, {1, 2, 3}, 50});
+		entities.push_back({2, 1, {4, 5, 6}, 75});
+		entities.erase_swap(0);
+	}
+	{
+		stc::mapped_swap_back_array<Entity> entities(table_path);
+		for (const Entity& e : entities)
+			std::cout << e.id << " ";
+		std::cout << std::endl;
+		entities.clear();
+	}
+
+
+	constexpr size_t count = 10'000'000;
+	{
+		stc::mapped_swap_back_array<Entity> entities(table_path);
+		entities.reserve(count);
+		std::ofstream dump(dump_path);
+		std::ofstream binary(binary_path, std::ios::binary);
+		for (uint32 i = 0; i < count; ++i)
+		{
+			Entity e{i, i % 16, {i * 0.5f, i * 0.25f, -float(i)}, float(i % 100)};
+			entities.push_back(e);
+			dump << e.id << ',' << e.archetype << ',' << e.position[0] << ',' << e.position[1] << ',' << e.position[2] << ',' << e.health << '\n';
+			binary.write(reinterpret_cast<const char*>(&e), sizeof(e));
+		}
+	}
+
+	std::cout << "\nCold load of " << count << " entities:\n\n"
+		<< std::left << std::setw(34) << "Method" << std::right << std::setw(15) << "open" << std::setw(15) << "first pass" << '\n';
+
+	PrintLoad("parse text dump", dump_path, [&]()
+	{
+		stc::swap_back_array<Entity> entities;
+		std::ifstream dump(dump_path);
+		std::string line;
+		while (std::getline(dump, line))
+			entities.push_back(ParseLine(line));
+		return entities;
+	});
+
+	PrintLoad("read binary dump", binary_path, [&]()
+	{
+		stc::swap_back_array<Entity> entities(std::filesystem::file_size(binary_path) / sizeof(Entity));
+		std::FILE* file = std::fopen(binary_path.c_str(), "rb");
+		auto read = std::fread(entities.data(), sizeof(Entity), entities.size(), file);
+		std::fclose(file);
+		entities.resize(read);
+		return entities;
+	});
+
+	using mapped = stc::mapped_swap_back_array<Entity>;
+	PrintLoad("mapped, checksum verified", table_path, [&]() { return mapped(table_path); });
+	PrintLoad("mapped, header checked", table_path, [&]() { return mapped(table_path, mapped::open_check::header); });
+
+	std::filesystem::remove(table_path);
+	std::filesystem::remove(dump_path);
+	std::filesystem::remove(binary_path);
+}
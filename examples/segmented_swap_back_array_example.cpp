@@ -0,0 +1,139 @@
+#include "../include/stc/segmented_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+struct Entity
+{
+	float position[3]{};
+	float velocity[3]{};
+	uint32 id = 0;
+	uint32 health = 100;
+};
+
+void PrintSSBA(const stc::segmented_swap_back_array<int32, 4>& ssba)
+{
+	// Compatible with range-based for loop, iterating across chunks.
+	for (int32 value : ssba)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+}
+
+// Times every emplace_back of count entities, and prints the latency distribution.
+template <typename Container>
+void PrintEmplaceLatency(std::string_view name, size_t count)
+{
+	using nano = std::chrono::nanoseconds;
+	std::vector<nano> latencies(count);
+
+	{
+		Container entities;
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			entities.emplace_back().id = uint32(i);
+			latencies[i] = std::chrono::steady_clock::now() - start;
+		}
+		benchmark::do_not_optimize(entities.size());
+	}
+
+	nano total{};
+	for (nano latency : latencies)
+		total += latency;
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&](double p) { return latencies[std::min(count - 1, size_t(count * p))].count(); };
+
+	std::cout << std::left << std::setw(22) << name << std::right
+		<< std::setw(12) << total.count() / 1'000'000 << " ms"
+		<< std::setw(12) << percentile(0.5) << " ns"
+		<< std::setw(12) << percentile(0.999) << " ns"
+		<< std::setw(14) << latencies.back().count() / 1'000 << " us\n";
+}
+
+int main()
+{
+	// Chunks of 4 elements, growing allocates a new chunk
+	stc::segmented_swap_back_array<int32, 4> data = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	int32* first = &data[0];
+	PrintSSBA(data);
+
+	// Pointers stay valid when the container grows
+	for (int32 i = 10; i < 100; ++i)
+		data.push_back(i);
+	std::cout << std::boolalpha << "first element moved: " << (first != &data[0]) << std::endl;
+
+	// Same removal as the swap back array
+	data.resize(10);
+	data.erase_swap(1);
+	data.erase_swap(2, 3);
+	PrintSSBA(data);
+
+	// Elements are contiguous within each chunk
+	for (size_t c = 0; c < data.chunk_count(); ++c)
+	{
+		std::cout << "chunk " << c << ": ";
+		for (int32 value : data.chunk(c))
+			std::cout << value << " ";
+		std::cout << std::endl;
+	}
+
+
+	std::cout << "\nSpeed comparison:\n";
+
+	// Growth without reserve: the vector-backed array reallocates and moves everything at once,
+	// the segmented array allocates one chunk at a time.
+	for (size_t count : {100'000, 1'000'000, 10'000'000})
+	{
+		std::cout << "\nemplace_back latency, " << count << " elements:\n\n"
+			<< std::left << std::setw(22) << "Container" << std::right
+			<< std::setw(15) << "Total" << std::setw(15) << "p50" << std::setw(15) << "p99.9" << std::setw(17) << "Max" << '\n'
+			<< std::string(84, '-') << '\n';
+
+		PrintEmplaceLatency<stc::swap_back_array<Entity>>("SBA", count);
+		PrintEmplaceLatency<stc::segmented_swap_back_array<Entity>>("Segmented SBA", count);
+		PrintEmplaceLatency<stc::segmented_swap_back_array<Entity, 16384>>("Segmented SBA (16K)", count);
+	}
+
+	// Indexed access pays for the chunk lookup, chunk spans do not
+	constexpr size_t entity_count = 1'000'000;
+	stc::swap_back_array<Entity> sba_entities(entity_count);
+	stc::segmented_swap_back_array<Entity> segmented_entities;
+	segmented_entities.resize(entity_count);
+
+	auto update_sba = [&]()
+	{
+		for (size_t i = 0; i < sba_entities.size(); ++i)
+			sba_entities[i].position[0] += sba_entities[i].velocity[0];
+		benchmark::do_not_optimize(sba_entities.data());
+	};
+
+	auto update_segmented_index = [&]()
+	{
+		for (size_t i = 0; i < segmented_entities.size(); ++i)
+			segmented_entities[i].position[0] += segmented_entities[i].velocity[0];
+		benchmark::do_not_optimize(segmented_entities[0]);
+	};
+
+	auto update_segmented_chunks = [&]()
+	{
+		for (size_t c = 0; c < segmented_entities.chunk_count(); ++c)
+		{
+			for (Entity& e : segmented_entities.chunk(c))
+				e.position[0] += e.velocity[0];
+		}
+		benchmark::do_not_optimize(segmented_entities[0]);
+	};
+
+	std::cout << "\nUpdate, " << entity_count << " entities:\n\n";
+	benchmark(100)
+		.add("SBA", update_sba)
+		.add("Segmented SBA, index", update_segmented_index)
+		.add("Segmented SBA, chunks", update_segmented_chunks)
+		.print_results();
+}
@@ -0,0 +1,89 @@
+#include "../include/stc/sharded_singleton.h"
+#include "../include/stc/eager_singleton.h"
+#include "../include/stc/integers.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+class AllocationStats : public stc::sharded_singleton<AllocationStats, 64>
+{
+	friend sharded_singleton;
+	AllocationStats() = default;
+
+public:
+
+	// Relaxed updates: a shard can be written by several threads, but rarely is.
+	void Record(uint64 bytes)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	std::atomic<uint64> count = 0;
+	std::atomic<uint64> total_bytes = 0;
+};
+
+class SharedAllocationStats : public stc::eager_singleton<SharedAllocationStats>
+{
+	friend eager_singleton;
+	SharedAllocationStats() = default;
+
+public:
+
+	void Record(uint64 bytes)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	std::atomic<uint64> count = 0;
+	std::atomic<uint64> total_bytes = 0;
+};
+
+// Runs record on thread_count threads, and returns the total millions of records per second.
+double MillionRecordsPerSecond(unsigned thread_count, auto record)
+{
+	constexpr size_t records_per_thread = 2'000'000;
+	std::vector<std::thread> threads;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			for (size_t i = 0; i < records_per_thread; ++i)
+				record(i % 256);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return thread_count * records_per_thread / elapsed.count() / 1e6;
+}
+
+int main()
+{
+	// Each thread records in the shard of its CPU
+	std::vector<std::thread> workers;
+	for (uint64 t = 1; t <= 4; ++t)
+		workers.emplace_back([t]() { AllocationStats::local().Record(t * 1024); });
+	for (auto& worker : workers)
+		worker.join();
+
+	// The shards are reduced into the logical value
+	auto bytes = AllocationStats::reduce(uint64(0), [](uint64 sum, const AllocationStats& s) { return sum + s.total_bytes.load(); });
+	std::cout << "shards: " << AllocationStats::shard_count << ", alignment: " << AllocationStats::shard_alignment
+		<< ", total bytes: " << bytes << std::endl;
+
+	std::cout << "\nRecords, millions per second:\n\n" << std::setw(8) << "Threads"
+		<< std::setw(10) << "sharded" << std::setw(10) << "shared" << '\n';
+
+	for (unsigned thread_count = 1; thread_count <= 64; thread_count *= 2)
+	{
+		std::cout << std::setw(8) << thread_count << std::fixed << std::setprecision(0)
+			<< std::setw(10) << MillionRecordsPerSecond(thread_count, [](uint64 bytes) { AllocationStats::local().Record(bytes); })
+			<< std::setw(10) << MillionRecordsPerSecond(thread_count, [](uint64 bytes) { SharedAllocationStats::instance().Record(bytes); }) << '\n';
+	}
+}
@@ -0,0 +1,115 @@
+#include "../include/stc/simd_search.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using level = stc::simd_search::level;
+
+const char* LevelName(level l)
+{
+	switch (l)
+	{
+	case level::sse2: return "sse2";
+	case level::avx2: return "avx2";
+	case level::avx512: return "avx512";
+	default: return "portable";
+	}
+}
+
+// Searches a value absent from bytes of elements, and prints the scanned GB/s of every supported kernel.
+template <typename T>
+void PrintScanThroughput(size_t bytes)
+{
+	stc::swap_back_array<T> ids(bytes / sizeof(T));
+	for (size_t i = 0; i < ids.size(); ++i)
+		ids[i] = T(i % 1000);
+
+	// scans about 4 GB per measurement
+	size_t repeats = std::max<size_t>(1, (size_t(4) << 30) / bytes);
+
+	std::cout << std::setw(8) << (bytes >= (1 << 20) ? std::to_string(bytes >> 20) + " MiB" : std::to_string(bytes >> 10) + " KiB");
+	for (level l : {level::portable, level::sse2, level::avx2, level::avx512})
+	{
+		if (l > stc::simd_search::supported_level())
+		{
+			std::cout << std::setw(10) << "-";
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t r = 0; r < repeats; ++r)
+			benchmark::do_not_optimize(stc::simd_search::find(ids.data(), ids.size(), T(5000), l));
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::cout << std::setw(10) << std::fixed << std::setprecision(1) << double(bytes) * repeats / elapsed.count() / 1e9;
+	}
+	std::cout << '\n';
+}
+
+template <typename T>
+void PrintScanTable(std::string_view name)
+{
+	std::cout << "\nScan of " << name << " ids for an absent value, GB/s:\n\n" << std::setw(8) << "Size";
+	for (level l : {level::portable, level::sse2, level::avx2, level::avx512})
+		std::cout << std::setw(10) << LevelName(l);
+	std::cout << '\n';
+
+	// from L1 to DRAM
+	for (size_t bytes = 16 << 10; bytes <= (size_t(256) << 20); bytes *= 4)
+		PrintScanThroughput<T>(bytes);
+}
+
+int main()
+{
+	stc::swap_back_array<uint32> data = {10, 11, 12, 13, 11, 14};
+
+	// Find and erase a value, searched with the widest vector instructions of the processor
+	std::cout << "kernel: " << LevelName(stc::simd_search::supported_level()) << std::endl;
+	std::cout << "index of 13: " << data.find_swap(13) - data.begin() << std::endl;
+	data.erase_swap_value(10);
+	data.erase_swap_all(11);
+	for (uint32 value : data)
+		std::cout << value << " ";
+	std::cout << std::endl;
+
+	PrintScanTable<uint32>("uint32");
+	PrintScanTable<uint64>("uint64");
+
+	// The usual pattern, find one id and erase it, in a list of 64K ids.
+	constexpr uint32 count = 1 << 16;
+	stc::swap_back_array<uint32> ids;
+	auto refill = [&]()
+	{
+		ids.clear();
+		for (uint32 i = 0; i < count; ++i)
+			ids.push_back(i);
+	};
+
+	std::cout << "\nFind and erase 1000 ids among " << count << ":\n\n";
+	benchmark(20)
+		.add("Iterator loop", [&]()
+		{
+			refill();
+			for (uint32 id = 0; id < count; id += count / 1000)
+			{
+				for (auto it = ids.begin(); it != ids.end(); ++it)
+				{
+					if (*it == id)
+					{
+						ids.erase_swap(it);
+						break;
+					}
+				}
+			}
+		})
+		.add("erase_swap_value", [&]()
+		{
+			refill();
+			for (uint32 id = 0; id < count; id += count / 1000)
+				ids.erase_swap_value(id);
+		})
+		.print_results();
+}
@@ -0,0 +1,123 @@
+#include "../include/stc/slot_map.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+struct Entity
+{
+	float position[3]{};
+	float velocity[3]{};
+	uint32 health = 100;
+};
+
+void PrintSM(const stc::slot_map<int32>& sm)
+{
+	// Compatible with range-based for loop, values are contiguous.
+	for (int32 value : sm)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	stc::slot_map<int32> data;
+
+	// Insertion returns a handle, stable for the whole lifetime of the element
+	auto h0 = data.insert(0);
+	auto h1 = data.insert(1);
+	auto h2 = data.emplace(2);
+	PrintSM(data);
+
+	// Erase in O(1), the last element is moved into the hole but its handle stays valid
+	data.erase(h0);
+	PrintSM(data);
+	std::cout << "h2 -> " << data[h2] << std::endl;
+
+	// Erased handles are detected as stale
+	std::cout << std::boolalpha << "h0 valid: " << data.contains(h0) << ", h1 valid: " << data.contains(h1) << std::endl;
+	if (int32* value = data.find(h1))
+		std::cout << "h1 -> " << *value << std::endl;
+
+
+	std::cout << "\nSpeed comparison:\n\n";
+
+	constexpr size_t entity_count = 100'000;
+
+	stc::slot_map<Entity> sm_comp;
+	std::unordered_map<uint32, Entity> map_comp;
+	std::vector<stc::slot_map<Entity>::handle> handles;
+	std::vector<uint32> ids;
+
+	sm_comp.reserve(entity_count);
+	map_comp.reserve(entity_count);
+	for (uint32 id = 0; id < entity_count; ++id)
+	{
+		handles.push_back(sm_comp.emplace());
+		map_comp.emplace(id, Entity{});
+		ids.push_back(id);
+	}
+
+	// Access in random order, like systems referring to each other
+	std::mt19937 rng(42);
+	std::vector<size_t> order(entity_count);
+	for (size_t i = 0; i < entity_count; ++i)
+		order[i] = i;
+	std::shuffle(order.begin(), order.end(), rng);
+
+	auto lookup_sm = [&](size_t i)
+	{
+		sm_comp[handles[order[i % entity_count]]].health -= 1;
+	};
+
+	auto lookup_map = [&](size_t i)
+	{
+		map_comp.find(ids[order[i % entity_count]])->second.health -= 1;
+	};
+
+	benchmark(1'000'000)
+		.add("Lookup slot_map", lookup_sm)
+		.add("Lookup unordered_map", lookup_map)
+		.print_results();
+
+	std::cout << '\n';
+
+	auto iterate_sm = [&]()
+	{
+		for (auto& entity : sm_comp)
+			entity.position[0] += entity.velocity[0];
+	};
+
+	auto iterate_map = [&]()
+	{
+		for (auto& [id, entity] : map_comp)
+			entity.position[0] += entity.velocity[0];
+	};
+
+	benchmark(100)
+		.add("Iterate slot_map", iterate_sm)
+		.add("Iterate unordered_map", iterate_map)
+		.print_results();
+
+	std::cout << '\n';
+
+	// Each iteration erases a different entity, half of them in total
+	auto erase_sm = [&](size_t i)
+	{
+		sm_comp.erase(handles[order[i]]);
+	};
+
+	auto erase_map = [&](size_t i)
+	{
+		map_comp.erase(ids[order[i]]);
+	};
+
+	benchmark(entity_count / 2)
+		.add("Erase slot_map", erase_sm)
+		.add("Erase unordered_map", erase_map)
+		.print_results();
+}
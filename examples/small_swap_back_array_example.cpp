@@ -0,0 +1,103 @@
+#include "../include/stc/small_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+
+// std::allocator counting its allocations.
+template <typename T>
+struct CountingAllocator : std::allocator<T>
+{
+	static inline size_t allocations = 0;
+
+	CountingAllocator() = default;
+	template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+	template <typename U> struct rebind { using other = CountingAllocator<U>; };
+
+	T* allocate(size_t n)
+	{
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+template <size_t N>
+void PrintSSBA(const stc::small_swap_back_array<int32, N>& ssba)
+{
+	// Compatible with range-based for loop.
+	for (int32 value : ssba)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << (ssba.is_inline() ? "(inline)" : "(heap)") << std::endl;
+}
+
+int main()
+{
+	// Up to 4 elements are stored inside the object
+	stc::small_swap_back_array<int32, 4> data = {0, 1, 2, 3};
+	PrintSSBA(data);
+
+	// Growing past 4 elements moves them to the heap
+	data.push_back(4);
+	data.push_back(5);
+	PrintSSBA(data);
+
+	// Same erase_swap overloads as swap_back_array
+	data.erase_swap(1);
+	data.erase_swap(data.begin(), data.begin() + 2);
+	PrintSSBA(data);
+
+	// Moves the elements back inline
+	data.shrink_to_fit();
+	PrintSSBA(data);
+
+
+	std::cout << "\nSpeed comparison:\n\n";
+
+	// Short-lived child lists, created, filled and destroyed
+	constexpr size_t child_count = 6;
+	using sba_type = stc::swap_back_array<uint32, CountingAllocator<uint32>>;
+	using ssba_type = stc::small_swap_back_array<uint32, 8, CountingAllocator<uint32>>;
+
+	auto create_sba = [&](size_t i)
+	{
+		sba_type children;
+		for (size_t c = 0; c < child_count; ++c)
+			children.push_back(uint32(i + c));
+		children.erase_swap(i % child_count);
+		benchmark::do_not_optimize(children.data());
+	};
+
+	auto create_ssba = [&](size_t i)
+	{
+		ssba_type children;
+		for (size_t c = 0; c < child_count; ++c)
+			children.push_back(uint32(i + c));
+		children.erase_swap(i % child_count);
+		benchmark::do_not_optimize(children.data());
+	};
+
+	constexpr size_t iterations = 1'000'000;
+	size_t sba_allocations = 0;
+	size_t ssba_allocations = 0;
+
+	auto counted = [](size_t& counter, auto&& c)
+	{
+		return [&counter, c](size_t i)
+		{
+			auto before = CountingAllocator<uint32>::allocations;
+			c(i);
+			counter += CountingAllocator<uint32>::allocations - before;
+		};
+	};
+
+	benchmark(iterations)
+		.add("Create/destroy SBA", counted(sba_allocations, create_sba))
+		.add("Create/destroy small SBA", counted(ssba_allocations, create_ssba))
+		.print_results();
+
+	std::cout << "\nAllocations per array:\n"
+		<< "SBA       " << double(sba_allocations) / iterations << '\n'
+		<< "small SBA " << double(ssba_allocations) / iterations << '\n';
+}
@@ -0,0 +1,121 @@
+#include "../include/stc/snapshot.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+struct Particle
+{
+	float position[3];
+	float velocity[3];
+	uint32 id;
+	uint32 flags;
+};
+
+// Non trivially copyable types are serialized through the customization point.
+struct Tag
+{
+	uint32 id;
+	std::string name;
+};
+
+template<>
+struct stc::snapshot_traits<Tag>
+{
+	static void write(std::ostream& out, const Tag& tag)
+	{
+		auto length = uint32(tag.name.size());
+		out.write(reinterpret_cast<const char*>(&tag.id), sizeof(tag.id));
+		out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		out.write(tag.name.data(), length);
+	}
+
+	static Tag read(std::istream& in)
+	{
+		Tag tag{};
+		uint32 length = 0;
+		in.read(reinterpret_cast<char*>(&tag.id), sizeof(tag.id));
+		in.read(reinterpret_cast<char*>(&length), sizeof(length));
+		tag.name.resize(in ? length : 0);
+		in.read(tag.name.data(), tag.name.size());
+		return tag;
+	}
+};
+
+// Times the callable, and prints the throughput for bytes.
+void PrintThroughput(std::string_view name, size_t bytes, auto callable)
+{
+	auto start = std::chrono::steady_clock::now();
+	callable();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << elapsed.count() * 1e3 << " ms" << std::setw(10) << bytes / elapsed.count() / 1e9 << " GB/s\n";
+}
+
+int main()
+{
+	stc::swap_back_array<Tag> tags = {{0, "player"}, {1, "enemy"}, {2, "projectile"}};
+	tags.erase_swap(0);
+
+	std::stringstream stream;
+	stc::write_snapshot(stream, tags);
+	stc::swap_back_array<Tag> restored;
+	stc::read_snapshot(stream, restored);
+	for (const Tag& tag : restored)
+		std::cout << tag.id << ":" << tag.name << " ";
+	std::cout << std::endl;
+
+
+	std::cout << "\nCheckpoint of 256 MiB:\n\n";
+
+	constexpr size_t count = 256 * 1024 * 1024 / sizeof(Particle);
+	constexpr size_t bytes = count * sizeof(Particle);
+	auto path = std::filesystem::temp_directory_path() / "stc_snapshot.bin";
+
+	stc::swap_back_array<Particle> particles(count);
+	for (size_t i = 0; i < count; ++i)
+		particles[i] = {{float(i), 0, 0}, {0, 1, 0}, uint32(i), 0};
+
+	PrintThroughput("write, per element", bytes, [&]()
+	{
+		std::ofstream out(path, std::ios::binary);
+		uint64 size = particles.size();
+		out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		for (const Particle& p : particles)
+			out.write(reinterpret_cast<const char*>(&p), sizeof(p));
+	});
+
+	PrintThroughput("write_snapshot", bytes, [&]()
+	{
+		std::ofstream out(path, std::ios::binary);
+		stc::write_snapshot(out, particles);
+	});
+
+	stc::swap_back_array<Particle> read;
+	PrintThroughput("read, per element", bytes, [&]()
+	{
+		std::ifstream in(path, std::ios::binary);
+		in.ignore(sizeof(stc::snapshot_header));
+		Particle p;
+		read.clear();
+		while (in.read(reinterpret_cast<char*>(&p), sizeof(p)))
+			read.push_back(p);
+	});
+
+	read = {};
+	PrintThroughput("read_snapshot", bytes, [&]()
+	{
+		std::ifstream in(path, std::ios::binary);
+		stc::read_snapshot(in, read);
+	});
+	std::cout << (read.size() == count && read.back().id == count - 1 ? "restored" : "mismatch") << '\n';
+
+	std::filesystem::remove(path);
+}
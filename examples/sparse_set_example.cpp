@@ -0,0 +1,128 @@
+#include "../include/stc/sparse_set.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// A set of keys below a fixed bound, one bit per key.
+class Bitset
+{
+public:
+
+	explicit Bitset(size_t key_bound) : words_((key_bound + 63) / 64) {}
+
+	bool insert(uint32 key)
+	{
+		auto bit = uint64(1) << (key % 64);
+		bool inserted = (words_[key / 64] & bit) == 0;
+		words_[key / 64] |= bit;
+		return inserted;
+	}
+
+	bool erase(uint32 key)
+	{
+		auto bit = uint64(1) << (key % 64);
+		bool erased = (words_[key / 64] & bit) != 0;
+		words_[key / 64] &= ~bit;
+		return erased;
+	}
+
+	bool contains(uint32 key) const { return (words_[key / 64] >> (key % 64)) & 1; }
+
+	// Iterating scans every word, whatever the number of keys.
+	template <typename F>
+	void for_each(F f) const
+	{
+		for (size_t w = 0; w < words_.size(); ++w)
+		{
+			for (uint64 bits = words_[w]; bits != 0; bits &= bits - 1)
+				f(uint32(w * 64 + std::countr_zero(bits)));
+		}
+	}
+
+private:
+
+	std::vector<uint64> words_;
+};
+
+// Returns the nanoseconds per operation of callable, which performs operations.
+double NanosecondsPerOperation(size_t operations, auto callable)
+{
+	auto start = std::chrono::steady_clock::now();
+	callable();
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / operations;
+}
+
+// Runs every operation on the three sets, with count random keys below key_bound.
+void BenchmarkSets(size_t count, uint32 key_bound)
+{
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<uint32> key_distribution(0, key_bound - 1);
+	std::vector<uint32> keys(count), queries(count);
+	for (auto& key : keys)
+		key = key_distribution(rng);
+	for (auto& query : queries)
+		query = key_distribution(rng);
+
+	std::cout << "\n" << count << " keys below " << key_bound << ", ns per operation:\n\n"
+		<< std::left << std::setw(12) << "Operation" << std::right
+		<< std::setw(14) << "sparse_set" << std::setw(16) << "unordered_set" << std::setw(10) << "bitset" << '\n';
+
+	stc::sparse_set<uint32> sparse;
+	std::unordered_set<uint32> hashed;
+	Bitset bits(key_bound);
+	uint64 sum = 0;
+
+	auto print_row = [](const char* name, double sparse_ns, double hashed_ns, double bits_ns)
+	{
+		std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(14) << sparse_ns << std::setw(16) << hashed_ns << std::setw(10) << bits_ns << '\n';
+	};
+
+	print_row("insert",
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) sparse.insert(key); }),
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) hashed.insert(key); }),
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) bits.insert(key); }));
+
+	print_row("contains",
+		NanosecondsPerOperation(count, [&]() { for (auto query : queries) sum += sparse.contains(query); }),
+		NanosecondsPerOperation(count, [&]() { for (auto query : queries) sum += hashed.contains(query); }),
+		NanosecondsPerOperation(count, [&]() { for (auto query : queries) sum += bits.contains(query); }));
+
+	print_row("iterate",
+		NanosecondsPerOperation(sparse.size(), [&]() { for (auto key : sparse) sum += key; }),
+		NanosecondsPerOperation(sparse.size(), [&]() { for (auto key : hashed) sum += key; }),
+		NanosecondsPerOperation(sparse.size(), [&]() { bits.for_each([&](uint32 key) { sum += key; }); }));
+
+	print_row("erase",
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) sparse.erase(key); }),
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) hashed.erase(key); }),
+		NanosecondsPerOperation(count, [&]() { for (auto key : keys) bits.erase(key); }));
+
+	benchmark::do_not_optimize(sum);
+}
+
+int main()
+{
+	stc::sparse_set<uint32> ids;
+	ids.insert(42);
+	ids.insert(7);
+	ids.insert(100'000);
+	ids.insert(3);
+	ids.erase(7);
+
+	// Keys are iterated densely, the last one took the place of the erased one
+	for (uint32 id : ids)
+		std::cout << id << " ";
+	std::cout << "\ncontains 42: " << std::boolalpha << ids.contains(42) << ", pages: " << ids.page_count() << std::endl;
+
+	// Dense and sparse sets of entity ids
+	BenchmarkSets(1'000'000, 1 << 22);
+	BenchmarkSets(10'000, 1 << 22);
+}
@@ -0,0 +1,81 @@
+#include "../include/stc/static_swap_back_array.h"
+#include "../include/stc/swap_back_array.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+
+// Built at compile time: erase_swap_if runs in constant evaluation.
+constexpr auto primes = []
+{
+	stc::static_swap_back_array<uint32, 64> values;
+	for (uint32 i = 2; i < 66; ++i)
+		values.push_back(i);
+
+	values.erase_swap_if([](uint32 value)
+	{
+		for (uint32 d = 2; d * d <= value; ++d)
+		{
+			if (value % d == 0)
+				return true;
+		}
+		return false;
+	});
+	return values;
+}();
+
+template <size_t Capacity>
+void PrintSSBA(const stc::static_swap_back_array<uint32, Capacity>& ssba)
+{
+	// Compatible with range-based for loop.
+	for (uint32 value : ssba)
+	{
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	static_assert(primes.size() == 18);
+	PrintSSBA(primes);
+
+	// Never allocates, the capacity is part of the type
+	stc::static_swap_back_array<uint32, 4> data = {0, 1, 2};
+	data.push_back(3);
+	PrintSSBA(data);
+
+	// Overflow is reported instead of throwing
+	if (!data.try_push_back(4))
+		std::cout << "Full, 4 not added" << std::endl;
+
+	// Same erase_swap overloads as swap_back_array
+	data.erase_swap(0);
+	PrintSSBA(data);
+
+
+	std::cout << "\nSpeed comparison:\n\n";
+
+	// Per-frame scratch list, filled then dropped
+	auto scratch_sba = [](size_t i)
+	{
+		stc::swap_back_array<uint32> scratch;
+		for (uint32 c = 0; c < 32; ++c)
+			scratch.push_back(uint32(i) + c);
+		scratch.erase_swap(i % 32);
+		benchmark::do_not_optimize(scratch.data());
+	};
+
+	auto scratch_ssba = [](size_t i)
+	{
+		stc::static_swap_back_array<uint32, 32> scratch;
+		for (uint32 c = 0; c < 32; ++c)
+			scratch.push_back(uint32(i) + c);
+		scratch.erase_swap(i % 32);
+		benchmark::do_not_optimize(scratch.data());
+	};
+
+	benchmark(1'000'000)
+		.add("Scratch SBA", scratch_sba)
+		.add("Scratch static SBA", scratch_ssba)
+		.print_results();
+}
@@ -1,8 +1,12 @@
 #include "../include/stc/swap_back_array.h"
+#include "../include/stc/swap_back_array_parallel.h"
 #include "../include/stc/integers.h"
 #include "benchmark.hpp"
+#include <algorithm>
 #include <random>
 #include <iostream>
+#include <string>
+#include <vector>
 
 void PrintSBA(const stc::swap_back_array<int>& sba)
 {
@@ -14,6 +18,100 @@ void PrintSBA(const stc::swap_back_array<int>& sba)
 	std::cout << std::endl;
 }
 
+template <size_t Size>
+struct pod_payload
+{
+	char bytes[Size];
+};
+
+// Same layout, but the user-provided assignment forces element-wise moves.
+template <size_t Size>
+struct elementwise_payload : pod_payload<Size>
+{
+	elementwise_payload() = default;
+	elementwise_payload(const elementwise_payload&) = default;
+	elementwise_payload& operator=(const elementwise_payload& other)
+	{
+		pod_payload<Size>::operator=(other);
+		return *this;
+	}
+};
+
+// Erase 1/4 of the elements in ranges of 64, refilling the array every iteration.
+template <size_t Size>
+void BenchmarkRangeErase()
+{
+	constexpr size_t count = (16 << 20) / Size;
+	constexpr size_t range_size = 64;
+
+	stc::swap_back_array<pod_payload<Size>> pod(count);
+	stc::swap_back_array<elementwise_payload<Size>> elementwise(count);
+
+	auto erase_pod = [&]()
+	{
+		pod.resize(count);
+		for (size_t start = 0; start + range_size < pod.size(); start += range_size * 3)
+			pod.erase_swap(start, range_size);
+		benchmark::do_not_optimize(pod.data());
+	};
+
+	auto erase_elementwise = [&]()
+	{
+		elementwise.resize(count);
+		for (size_t start = 0; start + range_size < elementwise.size(); start += range_size * 3)
+			elementwise.erase_swap(start, range_size);
+		benchmark::do_not_optimize(elementwise.data());
+	};
+
+	std::cout << "\nRange erase, " << count << " elements of " << Size << " bytes:\n\n";
+	benchmark(20)
+		.add("Block relocation", erase_pod)
+		.add("Element-wise move", erase_elementwise)
+		.print_results();
+}
+
+// Bursts: every queue fills up to a peak, then drains back to a small steady size one erase_swap at a time.
+template <typename ShrinkPolicy>
+void RunBursts(std::vector<stc::swap_back_array<pod_payload<64>, std::allocator<pod_payload<64>>, ShrinkPolicy>>& queues)
+{
+	constexpr size_t peak = 20'000;
+	constexpr size_t steady = 100;
+	for (auto& queue : queues)
+	{
+		while (queue.size() < peak)
+			queue.emplace_back();
+		while (queue.size() > steady)
+			queue.erase_swap(queue.size() / 2);
+	}
+	benchmark::do_not_optimize(queues.data());
+}
+
+template <typename ShrinkPolicy>
+size_t RetainedBytes(const std::vector<stc::swap_back_array<pod_payload<64>, std::allocator<pod_payload<64>>, ShrinkPolicy>>& queues)
+{
+	size_t bytes = 0;
+	for (const auto& queue : queues)
+		bytes += queue.capacity() * sizeof(pod_payload<64>);
+	return bytes;
+}
+
+void BenchmarkShrinkPolicy()
+{
+	constexpr size_t queue_count = 256;
+	using payload = pod_payload<64>;
+	std::vector<stc::swap_back_array<payload>> kept(queue_count);
+	std::vector<stc::swap_back_array<payload, std::allocator<payload>, stc::shrink_by_half<>>> shrunk(queue_count);
+
+	std::cout << "\nBursts in " << queue_count << " queues of 64 bytes elements, 20000 peak, 100 steady:\n\n";
+	benchmark(10)
+		.add("never_shrink", [&]() { RunBursts(kept); })
+		.add("shrink_by_half", [&]() { RunBursts(shrunk); })
+		.print_results();
+
+	std::cout << "\nRetained between bursts: never_shrink " << RetainedBytes(kept) / (1 << 20)
+		<< " MiB, shrink_by_half " << RetainedBytes(shrunk) / 1024 << " KiB\n";
+}
+
 int main()
 {
 	// Initialize with a list of values, same as std::vector
@@ -46,6 +144,11 @@ int main()
 	}
 	PrintSBA(data);
 
+	// Delete multiples of 3 in a single pass, returns the removed count
+	size_t removed = data.erase_swap_if([](int32 value) { return value % 3 == 0; });
+	std::cout << removed << " removed: ";
+	PrintSBA(data);
+
 	// Remove elements from index 3 to the end using iterators
 	data.erase_swap(data.begin() + 3, data.end());
 	PrintSBA(data);
@@ -108,4 +211,212 @@ int main()
 		.add("Erase SBA", erase_sba)
 		.add("Erase vector", erase_vec)
 		.print_results();
+
+	// Remove every element matching a predicate (~50% of them).
+	// Each iteration restores the source data first, this cost is shared by all contenders.
+	std::mt19937_64 rng(42);
+	for (size_t size = 1'000; size <= 10'000'000; size *= 10)
+	{
+		std::vector<size_t> source(size);
+		for (auto& value : source)
+			value = rng();
+
+		auto is_odd = [](size_t value) { return value % 2 != 0; };
+		std::vector<size_t> vec_pred;
+		stc::swap_back_array<size_t> sba_pred;
+		vec_pred.reserve(size);
+		sba_pred.reserve(size);
+
+		auto copy_only = [&]()
+		{
+			vec_pred.assign(source.begin(), source.end());
+		};
+
+		auto erase_if_vec = [&]()
+		{
+			vec_pred.assign(source.begin(), source.end());
+			std::erase_if(vec_pred, is_odd);
+		};
+
+		auto erase_swap_if_sba = [&]()
+		{
+			sba_pred.assign(source.begin(), source.end());
+			sba_pred.erase_swap_if(is_odd);
+		};
+
+		auto erase_swap_loop_sba = [&]()
+		{
+			sba_pred.assign(source.begin(), source.end());
+			for (auto it = sba_pred.begin(); it != sba_pred.end();)
+			{
+				if (is_odd(*it))
+					it = sba_pred.erase_swap(it);
+				else
+					++it;
+			}
+		};
+
+		std::cout << "\nErase if, " << size << " elements:\n\n";
+		benchmark(std::max<size_t>(1, 10'000'000 / size))
+			.add("Copy only", copy_only)
+			.add("std::erase_if vector", erase_if_vec)
+			.add("erase_swap_if SBA", erase_swap_if_sba)
+			.add("erase_swap loop SBA", erase_swap_loop_sba)
+			.print_results();
+	}
+
+	// Remove a batch of unsorted indices, from 0.1% to 90% of 1M elements.
+	constexpr size_t batch_size = 1'000'000;
+	std::vector<size_t> batch_source(batch_size);
+	for (size_t i = 0; i < batch_size; ++i)
+		batch_source[i] = i;
+
+	for (double ratio : {0.001, 0.01, 0.1, 0.5, 0.9})
+	{
+		std::vector<size_t> indices = batch_source;
+		std::shuffle(indices.begin(), indices.end(), rng);
+		indices.resize(size_t(batch_size * ratio));
+
+		stc::swap_back_array<size_t> sba_batch;
+		sba_batch.reserve(batch_size);
+		std::vector<size_t> sorted_indices;
+
+		auto copy_only = [&]()
+		{
+			sba_batch.assign(batch_source.begin(), batch_source.end());
+		};
+
+		auto erase_indices_sba = [&]()
+		{
+			sba_batch.assign(batch_source.begin(), batch_source.end());
+			sba_batch.erase_swap_indices(indices);
+		};
+
+		// The correct manual approach: erase from the highest index down.
+		auto erase_sorted_loop_sba = [&]()
+		{
+			sba_batch.assign(batch_source.begin(), batch_source.end());
+			sorted_indices = indices;
+			std::sort(sorted_indices.begin(), sorted_indices.end(), std::greater<>());
+			for (size_t index : sorted_indices)
+				sba_batch.erase_swap(index);
+		};
+
+		std::cout << "\nErase indices, " << ratio * 100 << "% of " << batch_size << " elements:\n\n";
+		benchmark(10)
+			.add("Copy only", copy_only)
+			.add("erase_swap_indices", erase_indices_sba)
+			.add("Sorted erase_swap loop", erase_sorted_loop_sba)
+			.print_results();
+	}
+
+	// Remove a batch of entities from a render list, keeping an external entity -> index table up to date.
+	// The manual bookkeeping checks the size before each erase_swap, the tracked variant reports all moves at once.
+	struct render_item
+	{
+		uint32 entity;
+		float depth;
+	};
+
+	constexpr size_t entity_count = 1'000'000;
+	for (double ratio : {0.01, 0.1, 0.5})
+	{
+		stc::swap_back_array<render_item> items;
+		items.reserve(entity_count);
+		std::vector<uint32> index_of(entity_count);
+		std::vector<size_t> indices(batch_source.begin(), batch_source.begin() + entity_count);
+		std::shuffle(indices.begin(), indices.end(), rng);
+		indices.resize(size_t(entity_count * ratio));
+		std::vector<size_t> sorted_indices;
+		std::vector<stc::relocation> moves(indices.size());
+
+		auto reset = [&]()
+		{
+			items.clear();
+			for (uint32 e = 0; e < entity_count; ++e)
+			{
+				items.push_back({e, float(e)});
+				index_of[e] = e;
+			}
+		};
+
+		auto manual_bookkeeping = [&]()
+		{
+			reset();
+			sorted_indices = indices;
+			std::sort(sorted_indices.begin(), sorted_indices.end(), std::greater<>());
+			for (size_t index : sorted_indices)
+			{
+				size_t last = items.size() - 1;
+				items.erase_swap(index);
+				if (index != last)
+					index_of[items[index].entity] = uint32(index);
+			}
+		};
+
+		auto tracked_batch = [&]()
+		{
+			reset();
+			auto moves_end = items.erase_swap_indices_tracked(indices, moves.data());
+			for (auto it = moves.data(); it != moves_end; ++it)
+				index_of[items[it->to].entity] = uint32(it->to);
+		};
+
+		std::cout << "\nErase and fix up indices, " << ratio * 100 << "% of " << entity_count << " elements:\n\n";
+		benchmark(10)
+			.add("Reset only", reset)
+			.add("Manual bookkeeping", manual_bookkeeping)
+			.add("erase_swap_indices_tracked", tracked_batch)
+			.print_results();
+	}
+
+	// Kill the particles whose life ran out, spreading the sweep over more and more threads.
+	struct particle
+	{
+		float position[3];
+		float life;
+	};
+
+	constexpr size_t particle_count = 10'000'000;
+	std::vector<particle> particle_source(particle_count);
+	std::uniform_real_distribution<float> life_distribution(0.f, 1.f);
+	for (auto& p : particle_source)
+		p.life = life_distribution(rng);
+
+	stc::swap_back_array<particle> particles;
+	particles.reserve(particle_count);
+	auto is_dead = [](const particle& p) { return p.life < 0.3f; };
+
+	std::cout << "\nErase if, " << particle_count << " particles, 30% removed:\n\n";
+	benchmark parallel_benchmark(5);
+	parallel_benchmark.add("Copy only", [&]()
+	{
+		particles.assign(particle_source.begin(), particle_source.end());
+	});
+	parallel_benchmark.add("erase_swap_if", [&]()
+	{
+		particles.assign(particle_source.begin(), particle_source.end());
+		particles.erase_swap_if(is_dead);
+	});
+
+	std::vector<std::string> thread_names;
+	for (unsigned thread_count = 1; thread_count <= 32; thread_count *= 2)
+		thread_names.push_back("erase_swap_if_parallel, " + std::to_string(thread_count) + " thread(s)");
+	for (unsigned thread_count = 1, i = 0; thread_count <= 32; thread_count *= 2, ++i)
+	{
+		parallel_benchmark.add(thread_names[i], [&]()
+		{
+			particles.assign(particle_source.begin(), particle_source.end());
+			stc::erase_swap_if_parallel(particles, is_dead, thread_count);
+		});
+	}
+	parallel_benchmark.print_results();
+
+	// Range erase of trivially copyable types relocates whole blocks with memcpy.
+	BenchmarkRangeErase<16>();
+	BenchmarkRangeErase<64>();
+	BenchmarkRangeErase<256>();
+
+	// Arrays serving bursts give their memory back once drained, with a shrink policy.
+	BenchmarkShrinkPolicy();
 }
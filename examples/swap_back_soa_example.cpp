@@ -0,0 +1,109 @@
+#include "../include/stc/swap_back_soa.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <iostream>
+#include <string>
+
+void PrintSBS(const stc::swap_back_soa<int32, std::string>& sbs)
+{
+	// Rows are accessed by index, columns are contiguous spans.
+	for (size_t i = 0; i < sbs.size(); ++i)
+	{
+		auto [number, name] = sbs.row(i);
+		std::cout << number << ":" << name << " ";
+	}
+	std::cout << std::endl;
+}
+
+// A typical entity, most passes only need a few of its fields.
+struct Particle
+{
+	float x, y, z;
+	float vx, vy, vz;
+	float color[4];
+	float size, lifetime, mass, drag;
+	uint32 flags;
+	uint32 id;
+};
+
+int main()
+{
+	// One argument per column
+	stc::swap_back_soa<int32, std::string> data;
+	for (int32 i = 0; i < 6; ++i)
+		data.emplace_back(i, "n" + std::to_string(i));
+	PrintSBS(data);
+
+	// Remove row at index 1 in O(1), all columns stay in sync
+	data.erase_swap(1);
+	PrintSBS(data);
+
+	// Remove 2 rows starting from index 2
+	data.erase_swap(2, 2);
+	PrintSBS(data);
+
+	// The predicate receives one reference per column
+	data.erase_swap_if([](int32 number, const std::string&) { return number == 0; });
+	PrintSBS(data);
+
+	// Loop over a single column
+	for (int32& number : data.column<0>())
+		number *= 10;
+	PrintSBS(data);
+
+
+	std::cout << "\nSpeed comparison:\n\n";
+
+	constexpr size_t particle_count = 1'000'000;
+
+	stc::swap_back_array<Particle> aos;
+	stc::swap_back_soa<float, float, float, float, float, float, float, float> soa; // x, y, z, vx, vy, vz, lifetime, mass
+	aos.reserve(particle_count);
+	soa.reserve(particle_count);
+	for (size_t i = 0; i < particle_count; ++i)
+	{
+		float f = float(i % 100);
+		aos.push_back({f, f, f, 1.f, 1.f, 1.f, {}, 1.f, f, 1.f, 0.f, 0u, uint32(i)});
+		soa.emplace_back(f, f, f, 1.f, 1.f, 1.f, f, 1.f);
+	}
+
+	// One field read-modify-write
+	auto age_aos = [&]()
+	{
+		for (auto& particle : aos)
+			particle.lifetime -= 0.016f;
+	};
+
+	auto age_soa = [&]()
+	{
+		for (float& lifetime : soa.column<6>())
+			lifetime -= 0.016f;
+	};
+
+	benchmark(100)
+		.add("Single field AoS", age_aos)
+		.add("Single field SoA", age_soa)
+		.print_results();
+
+	std::cout << '\n';
+
+	// Two fields, x += vx
+	auto move_aos = [&]()
+	{
+		for (auto& particle : aos)
+			particle.x += particle.vx * 0.016f;
+	};
+
+	auto move_soa = [&]()
+	{
+		auto x = soa.column<0>();
+		auto vx = soa.column<3>();
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] += vx[i] * 0.016f;
+	};
+
+	benchmark(100)
+		.add("Two fields AoS", move_aos)
+		.add("Two fields SoA", move_soa)
+		.print_results();
+}
@@ -0,0 +1,89 @@
+#include "../include/stc/thread_local_singleton.h"
+#include "../include/stc/lazy_singleton.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+class Metrics : public stc::thread_local_singleton<Metrics>
+{
+	friend thread_local_singleton;
+	Metrics() = default;
+
+public:
+
+	uint64 requests = 0;
+	uint64 bytes = 0;
+};
+
+class SharedMetrics : public stc::lazy_singleton<SharedMetrics>
+{
+	friend lazy_singleton;
+	SharedMetrics() = default;
+
+public:
+
+	std::atomic<uint64> requests = 0;
+};
+
+// One plain counter per thread, packed in an array: neighbours share a cache line.
+uint64 packed_counters[64];
+
+// Runs increment on thread_count threads, and returns the total millions of increments per second.
+double MillionIncrementsPerSecond(unsigned thread_count, auto increment)
+{
+	constexpr size_t increments_per_thread = 2'000'000;
+	std::vector<std::thread> threads;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]()
+		{
+			for (size_t i = 0; i < increments_per_thread; ++i)
+			{
+				increment(t);
+				// the memory clobber stores every increment, as counters spread through the code would
+				benchmark::do_not_optimize(i);
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return thread_count * increments_per_thread / elapsed.count() / 1e6;
+}
+
+int main()
+{
+	// Each thread updates its own instance
+	std::vector<std::thread> workers;
+	for (uint64 t = 1; t <= 4; ++t)
+	{
+		workers.emplace_back([t]()
+		{
+			Metrics::instance().requests += t;
+			Metrics::instance().bytes += t * 1024;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	// The instances of exited threads are still combined
+	auto requests = Metrics::combine(uint64(0), [](uint64 sum, const Metrics& m) { return sum + m.requests; });
+	std::cout << "instances: " << Metrics::instance_count() << ", requests: " << requests << std::endl;
+
+	std::cout << "\nCounter increments, millions per second:\n\n" << std::setw(8) << "Threads"
+		<< std::setw(14) << "thread_local" << std::setw(16) << "shared atomic" << std::setw(16) << "packed array" << '\n';
+
+	for (unsigned thread_count = 1; thread_count <= 64; thread_count *= 2)
+	{
+		std::cout << std::setw(8) << thread_count << std::fixed << std::setprecision(0)
+			<< std::setw(14) << MillionIncrementsPerSecond(thread_count, [](unsigned) { ++Metrics::instance().requests; })
+			<< std::setw(16) << MillionIncrementsPerSecond(thread_count, [](unsigned) { SharedMetrics::instance().requests.fetch_add(1, std::memory_order_relaxed); })
+			<< std::setw(16) << MillionIncrementsPerSecond(thread_count, [](unsigned t) { ++packed_counters[t]; }) << '\n';
+	}
+}
@@ -0,0 +1,124 @@
+#include "../include/stc/versioned_singleton.h"
+#include "../include/stc/integers.h"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+class Config : public stc::versioned_singleton<Config>
+{
+	friend versioned_singleton;
+
+	Config(uint32 version)
+		: version(version)
+		, weights(64, version)
+	{
+	}
+
+public:
+
+	uint32 Weight(size_t i) const { return weights[i % weights.size()]; }
+
+	uint32 version;
+	std::vector<uint32> weights;
+};
+
+// The usual alternative: readers share a lock, the writer swaps the configuration under an exclusive lock.
+struct LockedConfig
+{
+	uint32 Weight(size_t i) const { return weights[i % weights.size()]; }
+
+	uint32 version = 0;
+	std::vector<uint32> weights = std::vector<uint32>(64, 0);
+};
+
+LockedConfig locked_config;
+std::shared_mutex locked_config_mutex;
+
+void ReloadLockedConfig(uint32 version)
+{
+	LockedConfig fresh{ version, std::vector<uint32>(64, version) };
+	{
+		std::unique_lock lock(locked_config_mutex);
+		std::swap(locked_config, fresh);
+	}
+	// the previous configuration is destroyed out of the lock
+}
+
+// Runs reader_count readers timing each read, while the main thread reloads the configuration without pause.
+void BenchmarkReloadStorm(const char* name, unsigned reader_count, auto read, auto reload)
+{
+	constexpr size_t reads_per_reader = 1'000'000;
+	std::vector<std::vector<int64>> latencies(reader_count, std::vector<int64>(reads_per_reader));
+	std::atomic<unsigned> running = reader_count;
+	std::vector<std::thread> readers;
+	for (unsigned t = 0; t < reader_count; ++t)
+	{
+		readers.emplace_back([&, t]()
+		{
+			for (size_t i = 0; i < reads_per_reader; ++i)
+			{
+				auto start = std::chrono::steady_clock::now();
+				benchmark::do_not_optimize(read(i));
+				latencies[t][i] = (std::chrono::steady_clock::now() - start).count();
+			}
+			--running;
+		});
+	}
+
+	uint32 reloads = 0;
+	while (running.load() != 0)
+		reload(++reloads);
+	for (auto& reader : readers)
+		reader.join();
+
+	std::vector<int64> all;
+	for (auto& samples : latencies)
+		all.insert(all.end(), samples.begin(), samples.end());
+	std::sort(all.begin(), all.end());
+	double average = 0;
+	for (auto latency : all)
+		average += double(latency) / all.size();
+
+	std::cout << std::left << std::setw(16) << name << std::right << std::setw(8) << reader_count
+		<< std::setw(10) << reloads << std::fixed << std::setprecision(1) << std::setw(12) << average
+		<< std::setw(10) << all[all.size() / 2] << std::setw(10) << all[all.size() * 999 / 1000]
+		<< std::setw(12) << all.back() << '\n';
+}
+
+int main()
+{
+	Config::construct_instance(1u);
+	{
+		// The guard keeps its version alive, even if another thread reloads the configuration
+		auto config = Config::read();
+		Config::construct_instance(2u);
+		std::cout << "held version: " << config->version << ", current version: " << Config::read()->version << std::endl;
+	}
+
+	// Frees the replaced version, once no reader holds it
+	Config::synchronize();
+	std::cout << "retired versions: " << Config::retired_count() << std::endl;
+
+	std::cout << "\nReads during a reload storm, ns per read (timer included):\n\n"
+		<< std::left << std::setw(16) << "Approach" << std::right << std::setw(8) << "Readers" << std::setw(10) << "Reloads"
+		<< std::setw(12) << "average" << std::setw(10) << "median" << std::setw(10) << "p99.9" << std::setw(12) << "max" << '\n';
+
+	for (unsigned reader_count : { 1u, 4u })
+	{
+		BenchmarkReloadStorm("versioned", reader_count,
+			[](size_t i) { return Config::read()->Weight(i); },
+			[](uint32 version) { Config::construct_instance(version); });
+
+		BenchmarkReloadStorm("shared_mutex", reader_count,
+			[](size_t i) { std::shared_lock lock(locked_config_mutex); return locked_config.Weight(i); },
+			[](uint32 version) { ReloadLockedConfig(version); });
+	}
+
+	Config::destruct_instance();
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace stc
+{
+
+/**
+ * @brief Thread-safe singleton with on-demand construction and destruction.
+ *
+ * Same interface as explicit_singleton, but the lifetime of the instance follows an atomic state machine
+ * (empty, constructing, ready, destroying), so construct_instance and destruct_instance can be called from
+ * several threads at once. Only one of them changes the state at a time, the others wait for it to finish.
+ * instance() and try_instance() are a single acquire load on the hot path, without any write to shared memory.
+ *
+ * @note References returned before a destruction or a replacement dangle, as with explicit_singleton: the readers
+ * must be done with the instance before another thread destructs or replaces it.
+ * @note It is recommended to use this class with the CRTP idiom to fully leverage the provided syntax.
+ *
+ * @tparam T The type of the singleton instance.
+ */
+template <typename T>
+class concurrent_explicit_singleton
+{
+public:
+
+	/**
+	 * @brief Constructs the singleton instance using the provided arguments.
+	 *
+	 * If an instance is already constructed, it is replaced by the new one. If another thread is constructing
+	 * or destructing the instance, waits for it to finish first, so concurrent calls are applied one after another.
+	 *
+	 * @note If T's constructor throws, the singleton is left without an instance.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 * @return T& Reference to the newly constructed singleton instance.
+	 */
+	template <typename... Args>
+	static T& construct_instance(Args&&... args)
+	{
+		auto current = lock(state::constructing);
+		if (current == state::ready)
+			storage_<>.instance_.~T();
+
+		try
+		{
+			new (&storage_<>.instance_) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			unlock(state::empty);
+			throw;
+		}
+
+		unlock(state::ready);
+		return storage_<>.instance_;
+	}
+
+	/**
+	 * @brief Checks whether the singleton instance has been constructed.
+	 *
+	 * @return bool True if the instance is ready, false otherwise (including while it is being constructed).
+	 */
+	[[nodiscard]] static bool instance_constructed() noexcept
+	{
+		return state_.load(std::memory_order_acquire) == state::ready;
+	}
+
+	/**
+	 * @brief Retrieves the singleton instance.
+	 *
+	 * @note Calling this function while the instance is not ready is undefined behavior.
+	 *
+	 * @return T& Reference to the singleton instance.
+	 */
+	[[nodiscard]] static T& instance() noexcept
+	{
+		// orders the accesses to the instance after its construction
+		[[maybe_unused]] auto current = state_.load(std::memory_order_acquire);
+		assert(current == state::ready && "Accessing uninitialized singleton instance.");
+		return storage_<>.instance_;
+	}
+
+	/**
+	 * @brief Retrieves the singleton instance, if it is ready.
+	 *
+	 * @return T* Pointer to the singleton instance, or nullptr if it is not ready.
+	 */
+	[[nodiscard]] static T* try_instance() noexcept
+	{
+		return state_.load(std::memory_order_acquire) == state::ready ? &storage_<>.instance_ : nullptr;
+	}
+
+	/**
+	 * @brief Destructs the singleton instance, after any construction in progress on another thread.
+	 *
+	 * @note Subsequent calls to instance() without re-initializing is undefined behavior.
+	 */
+	static void destruct_instance() noexcept
+	{
+		if (lock(state::destroying) == state::ready)
+			storage_<>.instance_.~T();
+		unlock(state::empty);
+	}
+
+protected:
+
+	// Enables construction of T.
+	concurrent_explicit_singleton() = default;
+
+private:
+
+	// Disable copy and move semantics.
+	concurrent_explicit_singleton(const concurrent_explicit_singleton&) = delete;
+	concurrent_explicit_singleton(concurrent_explicit_singleton&&) = delete;
+	concurrent_explicit_singleton& operator=(const concurrent_explicit_singleton&) = delete;
+	concurrent_explicit_singleton& operator=(concurrent_explicit_singleton&&) = delete;
+
+	enum class state : std::uint8_t
+	{
+		empty,
+		constructing,
+		ready,
+		destroying,
+	};
+
+	// Moves from empty or ready to the transient state, waiting for the transitions of other threads.
+	// Returns the state it moved from.
+	static state lock(state transient) noexcept
+	{
+		auto current = state_.load(std::memory_order_relaxed);
+		while (true)
+		{
+			if (current == state::constructing || current == state::destroying)
+			{
+				state_.wait(current, std::memory_order_relaxed);
+				current = state_.load(std::memory_order_relaxed);
+			}
+			else if (state_.compare_exchange_weak(current, transient, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return current;
+			}
+		}
+	}
+
+	// Leaves the transient state, publishing the instance to the acquire loads, and wakes the waiting threads.
+	static void unlock(state stable) noexcept
+	{
+		state_.store(stable, std::memory_order_release);
+		state_.notify_all();
+	}
+
+	// Leaves the instance uninitialized until construct_instance.
+	template <typename U>
+	union storage
+	{
+		storage() {};
+		~storage() { destruct_instance(); }
+
+		U instance_;
+	};
+
+	// A template, so that the storage is only instantiated by the member functions, once T is complete.
+	template <typename U = T>
+	static inline storage<U> storage_;
+	static inline std::atomic<state> state_ = state::empty;
+};
+
+} // namespace stc
@@ -0,0 +1,196 @@
+#pragma once
+#include "swap_back_array.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stc
+{
+
+/**
+ * @brief A swap_back_array accepting appends and removals from several threads at once.
+ *
+ * Elements live in a buffer reserved up front. Appending claims the next slot with an atomic cursor, without
+ * locking, and fails once the capacity is reached. Removals are deferred: erase_swap records the index in a
+ * queue owned by the calling thread, and the owner applies every queued removal at a sync point with flush().
+ *
+ * The concurrent operations are try_emplace_back, try_push_back and erase_swap. Every other member function
+ * must only be called by the owner at a sync point, when no concurrent operation is running and every
+ * previous one happens-before the call (e.g. after joining the worker threads or passing a barrier).
+ *
+ * @note Indices given to erase_swap refer to the layout since the last flush: appends never move elements.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam Allocator Allocator used for the element buffer (defaults to std::allocator<T>).
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class concurrent_swap_back_array
+{
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	/**
+	 * @brief Constructs an empty concurrent_swap_back_array able to hold capacity elements.
+	 *
+	 * @param capacity The number of elements that can be appended before a reserve.
+	 * @param alloc The allocator used for the element buffer.
+	 */
+	explicit concurrent_swap_back_array(size_type capacity, const Allocator& alloc = Allocator());
+
+	concurrent_swap_back_array(const concurrent_swap_back_array&) = delete;
+	concurrent_swap_back_array& operator=(const concurrent_swap_back_array&) = delete;
+
+	~concurrent_swap_back_array();
+
+	/**
+	 * @brief Constructs an element at the end of the container, from any thread.
+	 *
+	 * The slot is claimed with an atomic compare-exchange on the cursor, then the element is constructed in place.
+	 *
+	 * @note Construction must not throw, as the claimed slot could not be given back.
+	 * @note The element can only be read by other threads after a sync point.
+	 *
+	 * @param args Arguments forwarded to the constructor of T.
+	 * @return Pointer to the new element, or nullptr if the container is full.
+	 */
+	template<typename... Args>
+		requires std::is_nothrow_constructible_v<T, Args...>
+	T* try_emplace_back(Args&&... args) noexcept;
+
+	/**
+	 * @brief Copies or moves an element at the end of the container, from any thread.
+	 *
+	 * @param value The value to add.
+	 * @return Pointer to the new element, or nullptr if the container is full.
+	 */
+	template<typename U>
+		requires std::is_nothrow_constructible_v<T, U>
+	T* try_push_back(U&& value) noexcept { return try_emplace_back(std::forward<U>(value)); }
+
+	/**
+	 * @brief Queues the removal of the element at the specified index, from any thread.
+	 *
+	 * The index is recorded in a queue owned by the calling thread. The element stays in place until the next flush().
+	 * Each thread caches the queue it used last, a lock is only taken when it switches to another container.
+	 *
+	 * @note The user must provide a valid index (index < size() at the time of the next flush()).
+	 *
+	 * @param element_index The index of the element to remove.
+	 */
+	void erase_swap(size_type element_index);
+
+	/**
+	 * @brief Applies all queued removals, as a single swap_back_array::erase_swap_indices call would.
+	 *
+	 * @note Must be called at a sync point.
+	 *
+	 * @return The number of removed elements. An index queued several times is removed once.
+	 */
+	size_type flush();
+
+	/**
+	 * @brief Applies all queued removals, and reports the moved elements.
+	 *
+	 * @note Must be called at a sync point.
+	 *
+	 * @param out Output iterator receiving one relocation record per moved element.
+	 * @return out, past the last written record.
+	 */
+	template <std::output_iterator<relocation> Out>
+	Out flush_tracked(Out out);
+
+	/**
+	 * @brief Number of removals queued since the last flush(), duplicates included.
+	 */
+	size_type pending_erase_count() const noexcept;
+
+	/**
+	 * @brief Grows the buffer to hold at least new_capacity elements.
+	 * With a reallocating_allocator and trivially relocatable elements, the allocator resizes the buffer.
+	 *
+	 * @note Must be called at a sync point. Invalidates pointers to the elements.
+	 *
+	 * @param new_capacity The number of elements that can be appended before the next reserve.
+	 */
+	void reserve(size_type new_capacity);
+
+	/**
+	 * @brief Destroys all elements and drops the queued removals.
+	 *
+	 * @note Must be called at a sync point.
+	 */
+	void clear() noexcept;
+
+	T& operator[](size_type index) noexcept { assert(index < size()); return data_[index]; }
+	const T& operator[](size_type index) const noexcept { assert(index < size()); return data_[index]; }
+
+	T* data() noexcept { return data_; }
+	const T* data() const noexcept { return data_; }
+
+	iterator begin() noexcept { return data_; }
+	const_iterator begin() const noexcept { return data_; }
+	iterator end() noexcept { return data_ + size(); }
+	const_iterator end() const noexcept { return data_ + size(); }
+
+	/**
+	 * @brief Number of claimed slots. Other threads may still be constructing the newest elements.
+	 */
+	size_type size() const noexcept { return cursor_.load(std::memory_order_relaxed); }
+	bool empty() const noexcept { return size() == 0; }
+	bool full() const noexcept { return size() == capacity_; }
+	size_type capacity() const noexcept { return capacity_; }
+
+private:
+
+	struct erase_queue
+	{
+		std::thread::id owner;
+		std::vector<size_type> indices;
+	};
+
+	// Finds or registers the queue of the calling thread.
+	erase_queue& local_queue();
+
+	// Collects the queued indices, removes them and calls on_move(from, to) for each moved element.
+	template <typename OnMove>
+	size_type flush_impl(OnMove on_move);
+
+	// Destroys the elements from index new_size to the end.
+	void destroy_back_to(size_type new_size) noexcept;
+
+	// Identifies a container in the thread local queue caches, addresses can be reused.
+	static inline std::atomic<std::uint64_t> next_id_ = 0;
+
+	T* data_ = nullptr;
+	size_type capacity_ = 0;
+	alignas(64) std::atomic<size_type> cursor_ = 0;
+	alignas(64) std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+	std::mutex queues_mutex_;
+	std::vector<std::unique_ptr<erase_queue>> queues_;
+	std::vector<size_type> flushed_indices_;
+	[[no_unique_address]] Allocator alloc_;
+};
+
+} // namespace stc
+
+#include "../../src/concurrent_swap_back_array.inl"
@@ -0,0 +1,56 @@
+#pragma once
+
+namespace stc
+{
+
+/**
+ * @brief Singleton constant-initialized at compile time.
+ *
+ * The instance is defined constinit: it is initialized before any dynamic initialization, so it has neither the
+ * guard of lazy_singleton nor the 'Static Initialization Order Fiasco' of eager_singleton, and can be used from
+ * the constructors of other static objects. instance() is the address of the static storage.
+ * @see https://en.cppreference.com/w/cpp/language/constinit
+ *
+ * @note T must be constant-initializable: its default constructor must be constexpr, otherwise the program does not
+ * compile. Its destructor still runs at static destruction, in the reverse order of the dynamic initializations.
+ * @note It is recommended to use this class with the CRTP idiom to fully leverage the provided syntax.
+ *
+ * @tparam T The type of the singleton instance.
+ */
+template <typename T>
+class constinit_singleton
+{
+public:
+
+	/**
+	 * @brief Retrieves the singleton instance.
+	 *
+	 * @return T& Reference to the singleton instance.
+	 */
+	[[nodiscard]] static T& instance() noexcept
+	{
+		return instance_;
+	}
+
+protected:
+
+	// Enables construction of T.
+	constinit_singleton() = default;
+
+private:
+
+	// Disable copy and move semantics.
+	constinit_singleton(const constinit_singleton&) = delete;
+	constinit_singleton(constinit_singleton&&) = delete;
+	constinit_singleton& operator=(const constinit_singleton&) = delete;
+	constinit_singleton& operator=(constinit_singleton&&) = delete;
+
+	// The constant-initialized singleton instance.
+	static T instance_;
+};
+
+// Definition after the class, once T is fully known. Fails to compile if T cannot be constant-initialized.
+template <typename T>
+constinit inline T constinit_singleton<T>::instance_{};
+
+} // namespace stc
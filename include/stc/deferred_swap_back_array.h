@@ -0,0 +1,228 @@
+#pragma once
+#include "swap_back_array.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace stc
+{
+
+/**
+ * @brief A swap_back_array whose removals are deferred, so that elements can be erased while iterating.
+ *
+ * erase_deferred only marks a slot as erased in a bitset: no element moves, and every index, iterator, pointer
+ * and reference stays valid, including in nested loops and callbacks iterating the same container. Iteration
+ * skips the erased slots, 64 of them per bitset word. compact() then removes every erased slot in a single
+ * swap-back pass, moving at most one survivor per erased slot.
+ *
+ * @note Erased elements are only destroyed by compact(), clear() or the destructor.
+ * @note Inserting an element may reallocate, and invalidate pointers, references and iterators, like std::vector.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam Allocator Allocator used for memory management (defaults to std::allocator<T>).
+ * @tparam ShrinkPolicy Policy reducing the capacity after compact() (defaults to never_shrink, keeping it).
+ */
+template<typename T, typename Allocator = std::allocator<T>, shrink_policy ShrinkPolicy = never_shrink>
+class deferred_swap_back_array
+{
+	template <bool Const>
+	class basic_iterator;
+
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	constexpr deferred_swap_back_array() = default;
+
+	/**
+	 * @brief Constructs an empty deferred_swap_back_array using the given allocator.
+	 *
+	 * @param alloc The allocator used by the elements and the erased bitset.
+	 */
+	constexpr explicit deferred_swap_back_array(const Allocator& alloc);
+
+	/**
+	 * @brief Constructs an element in place at the end of the container.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 * @return T& Reference to the new element.
+	 */
+	template <typename... Args>
+	constexpr T& emplace_back(Args&&... args);
+
+	constexpr void push_back(const T& value) { emplace_back(value); }
+	constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	/**
+	 * @brief Marks the element at the specified slot as erased, in O(1) time and without moving anything.
+	 *
+	 * Erasing an already erased slot is allowed, and does nothing.
+	 *
+	 * @note The user must provide a valid index (index < slot_count()).
+	 *
+	 * @param index The slot of the element to erase.
+	 * @return bool True if the element was live, false if it was already erased.
+	 */
+	constexpr bool erase_deferred(size_type index) noexcept;
+
+	/**
+	 * @brief Marks the element at the specified iterator as erased. Iterators stay valid.
+	 *
+	 * @param it The iterator pointing to the element to erase.
+	 * @return bool True if the element was live, false if it was already erased.
+	 */
+	constexpr bool erase_deferred(const_iterator it) noexcept { return erase_deferred(it.index()); }
+
+	/**
+	 * @brief Removes every erased slot in a single pass, and applies the shrink policy.
+	 *
+	 * Erased slots below the new size are filled by the live elements above it, scanned from the end, like
+	 * erase_swap_indices. Afterwards, slots are dense again: slot i is the i-th element.
+	 *
+	 * @note The type T must be move-assignable in order to use this method.
+	 *
+	 * @return size_type The number of removed elements.
+	 */
+	constexpr size_type compact() noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes every erased slot in a single pass, and reports the moved elements.
+	 *
+	 * Same as compact(). One record is written per moved element, at most erased_count().
+	 * Not noexcept, as writing through out may throw (e.g. a std::back_insert_iterator).
+	 *
+	 * @param out Output iterator receiving the relocation records, e.g. a pointer into a caller-provided buffer.
+	 * @return out, past the last written record.
+	 */
+	template <std::output_iterator<relocation> Out>
+	constexpr Out compact_tracked(Out out);
+
+	/**
+	 * @brief Checks whether the slot at the specified index was erased, and not compacted yet.
+	 *
+	 * @note The user must provide a valid index (index < slot_count()).
+	 */
+	[[nodiscard]] constexpr bool is_erased(size_type index) const noexcept;
+
+	/**
+	 * @brief Retrieves the element at the specified slot.
+	 *
+	 * @note The slot must be valid and live (index < slot_count() and !is_erased(index)).
+	 */
+	[[nodiscard]] constexpr T& operator[](size_type index) noexcept;
+	[[nodiscard]] constexpr const T& operator[](size_type index) const noexcept;
+
+	/**
+	 * @brief Destroys every element, live or erased.
+	 */
+	constexpr void clear() noexcept;
+
+	/**
+	 * @brief Reserves storage for at least new_capacity slots.
+	 *
+	 * @param new_capacity The number of slots to reserve storage for.
+	 */
+	constexpr void reserve(size_type new_capacity);
+
+	/**
+	 * @brief Returns the number of live elements.
+	 */
+	[[nodiscard]] constexpr size_type size() const noexcept { return values_.size() - erased_count_; }
+	[[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+	/**
+	 * @brief Returns the number of slots, live or erased. Slot indices are below it.
+	 */
+	[[nodiscard]] constexpr size_type slot_count() const noexcept { return values_.size(); }
+
+	/**
+	 * @brief Returns the number of erased slots waiting for compact().
+	 */
+	[[nodiscard]] constexpr size_type erased_count() const noexcept { return erased_count_; }
+
+	[[nodiscard]] constexpr size_type capacity() const noexcept { return values_.capacity(); }
+
+	[[nodiscard]] constexpr iterator begin() noexcept { return {this, next_live(0)}; }
+	[[nodiscard]] constexpr iterator end() noexcept { return {this, slot_count()}; }
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return {this, next_live(0)}; }
+	[[nodiscard]] constexpr const_iterator end() const noexcept { return {this, slot_count()}; }
+	[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+	[[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+private:
+
+	using word_allocator = std::allocator_traits<Allocator>::template rebind_alloc<std::uint64_t>;
+
+	static constexpr size_type word_bits = 64;
+
+	// Returns the first live slot at or after index, or slot_count().
+	[[nodiscard]] constexpr size_type next_live(size_type index) const noexcept;
+
+	// Fills the erased slots below the new size, calling on_move(from, to) for each moved element, then truncates.
+	template <typename OnMove>
+	constexpr size_type compact_slots(OnMove on_move) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	swap_back_array<T, Allocator, ShrinkPolicy> values_;
+	// One bit per slot, set when erased. Bits past slot_count() are always clear.
+	std::vector<std::uint64_t, word_allocator> erased_;
+	size_type erased_count_ = 0;
+};
+
+/**
+ * @brief Forward iterator over the live elements of a deferred_swap_back_array, holding a slot index.
+ */
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<bool Const>
+class deferred_swap_back_array<T, Allocator, ShrinkPolicy>::basic_iterator
+{
+	using container = std::conditional_t<Const, const deferred_swap_back_array, deferred_swap_back_array>;
+
+public:
+
+	using iterator_concept = std::forward_iterator_tag;
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = std::conditional_t<Const, const T*, T*>;
+	using reference = std::conditional_t<Const, const T&, T&>;
+
+	constexpr basic_iterator() noexcept = default;
+	constexpr basic_iterator(container* owner, size_type index) noexcept : owner_(owner), index_(index) {}
+
+	// Mutable iterators convert to const ones.
+	constexpr operator basic_iterator<true>() const noexcept requires (!Const) { return {owner_, index_}; }
+
+	[[nodiscard]] constexpr reference operator*() const noexcept { return owner_->values_.data()[index_]; }
+	[[nodiscard]] constexpr pointer operator->() const noexcept { return owner_->values_.data() + index_; }
+
+	/**
+	 * @brief Returns the slot index of the element the iterator points to.
+	 */
+	[[nodiscard]] constexpr size_type index() const noexcept { return index_; }
+
+	constexpr basic_iterator& operator++() noexcept { index_ = owner_->next_live(index_ + 1); return *this; }
+	constexpr basic_iterator operator++(int) noexcept { auto copy = *this; ++*this; return copy; }
+
+	[[nodiscard]] friend constexpr bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.index_ == b.index_; }
+
+private:
+
+	container* owner_ = nullptr;
+	size_type index_ = 0;
+};
+
+} // namespace stc
+
+#include "../../src/deferred_swap_back_array.inl"
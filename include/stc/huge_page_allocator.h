@@ -0,0 +1,148 @@
+#pragma once
+#include "trivially_relocatable.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief A memory resource backing large allocations with huge pages, to reduce TLB misses over large arrays.
+ *
+ * On Linux, a large allocation is rounded up to a multiple of huge_page_size and mapped with mmap. Explicit huge
+ * pages (MAP_HUGETLB) are tried first. When none are reserved, the mapping is aligned to huge_page_size and
+ * advised with MADV_HUGEPAGE, for the kernel to back it with transparent huge pages. When transparent huge pages
+ * are disabled too, the mapping silently keeps normal pages. Allocations smaller than min_huge_allocation, and every
+ * allocation on other platforms, go to the global operator new.
+ *
+ * reallocate() grows or shrinks large allocations with mremap, which extends the mapping in place or moves its pages
+ * without copying them, so growing never needs twice the memory.
+ *
+ * Use it with containers through huge_page_allocator.
+ *
+ * @note Thread-safe.
+ */
+class huge_page_resource
+{
+public:
+
+	using size_type = std::size_t;
+
+	/**
+	 * @brief Size of a huge page, the granularity of large allocations.
+	 */
+	static constexpr size_type huge_page_size = 2 * 1024 * 1024;
+
+	/**
+	 * @brief Smallest allocation backed by huge pages.
+	 */
+	static constexpr size_type min_huge_allocation = huge_page_size;
+
+	/**
+	 * @brief Allocates bytes of memory aligned to alignment. Large allocations are aligned to huge_page_size.
+	 *
+	 * @param bytes The size of the allocation.
+	 * @param alignment The alignment of the allocation.
+	 * @return Pointer to the allocated memory.
+	 * @throws std::bad_alloc if the memory cannot be mapped.
+	 */
+	[[nodiscard]] static void* allocate(size_type bytes, size_type alignment = alignof(std::max_align_t));
+
+	/**
+	 * @brief Releases memory returned by allocate.
+	 *
+	 * @param ptr Pointer returned by allocate.
+	 * @param bytes The size given to allocate.
+	 * @param alignment The alignment given to allocate.
+	 */
+	static void deallocate(void* ptr, size_type bytes, size_type alignment = alignof(std::max_align_t)) noexcept;
+
+	/**
+	 * @brief Resizes an allocation, keeping the bytes it holds up to the smaller size.
+	 *
+	 * Large allocations are remapped without copying when possible, other allocations are copied to a new one.
+	 * On success ptr is released, on failure it is left untouched.
+	 *
+	 * @param ptr Pointer returned by allocate.
+	 * @param old_bytes The size given to allocate.
+	 * @param new_bytes The new size.
+	 * @param alignment The alignment given to allocate.
+	 * @return Pointer to the resized memory, possibly ptr.
+	 * @throws std::bad_alloc if the memory cannot be mapped.
+	 */
+	[[nodiscard]] static void* reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment = alignof(std::max_align_t));
+
+	/**
+	 * @brief Returns true if the system handed out explicit huge pages, or has not been asked yet.
+	 * It becomes false for the rest of the process after the first failure, as the pool is reserved at boot.
+	 */
+	[[nodiscard]] static bool explicit_huge_pages_available() noexcept
+	{
+		return !explicit_pages_unavailable_.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	static constexpr size_type round_to_huge_pages(size_type bytes) noexcept
+	{
+		return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+	}
+
+	static void* map_huge_pages(size_type bytes);
+
+	// Maps size bytes of normal pages aligned to huge_page_size, returns nullptr on failure.
+	static void* map_aligned(size_type size) noexcept;
+
+	inline static std::atomic<bool> explicit_pages_unavailable_ = false;
+};
+
+/**
+ * @brief A standard allocator backing large allocations with huge pages, through huge_page_resource.
+ *
+ * Stateless: every instance compares equal, so containers can exchange buffers freely.
+ * It is a reallocating_allocator: containers owning their storage grow buffers of trivially relocatable
+ * elements through reallocate(), which remaps large buffers instead of copying them.
+ *
+ * @tparam T Type of the allocated objects.
+ */
+template<typename T>
+class huge_page_allocator
+{
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using is_always_equal = std::true_type;
+
+	huge_page_allocator() noexcept = default;
+
+	template<typename U>
+	huge_page_allocator(const huge_page_allocator<U>&) noexcept {}
+
+	[[nodiscard]] T* allocate(size_type count);
+	void deallocate(T* ptr, size_type count) noexcept;
+
+	/**
+	 * @brief Resizes a buffer of trivially relocatable elements, see huge_page_resource::reallocate.
+	 *
+	 * @param ptr Pointer returned by allocate.
+	 * @param old_count The count given to allocate.
+	 * @param new_count The new count.
+	 * @return Pointer to the resized buffer, holding the first min(old_count, new_count) elements of ptr.
+	 */
+	[[nodiscard]] T* reallocate(T* ptr, size_type old_count, size_type new_count)
+		requires is_trivially_relocatable_v<T>;
+};
+
+template<typename T, typename U>
+bool operator==(const huge_page_allocator<T>&, const huge_page_allocator<U>&) noexcept
+{
+	return true;
+}
+
+} // namespace stc
+
+#include "../../src/huge_page_allocator.inl"
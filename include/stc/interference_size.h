@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+/**
+ * @file
+ * @brief Cache line size shared by the containers and singletons that isolate their data from false sharing.
+ */
+
+namespace stc
+{
+
+#ifdef __cpp_lib_hardware_interference_size
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+/**
+ * @brief Minimum offset between two objects to avoid false sharing.
+ */
+inline constexpr std::size_t destructive_interference = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t destructive_interference = 64;
+#endif
+
+} // namespace stc
@@ -0,0 +1,204 @@
+#pragma once
+#include "swap_partition.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief A swap_back_array stored in a memory-mapped file, which reopens without parsing.
+ *
+ * The file starts with a 64-byte header (element size and alignment, size, capacity and checksum) followed by the
+ * elements, exactly as they are laid out in memory. Operations work directly on the mapping, so the file always
+ * holds the current elements, and reopening it only maps it back. Growth extends the file and the mapping.
+ *
+ * The checksum covers the size and the elements. It is updated by sync() and by the destructor, and verified when
+ * opening, so a file modified by a process that did not close it cleanly, or corrupted on disk, is rejected.
+ *
+ * @note POSIX only. The file must only be opened once at a time, and not be shared between machines of different
+ * endianness. Elements must not store pointers, which are meaningless in another process.
+ *
+ * @tparam T Type of elements stored in the container, it must be trivially copyable.
+ */
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+class mapped_swap_back_array
+{
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	/**
+	 * @brief Size of the file header, the elements start at this offset.
+	 */
+	static constexpr size_type header_size = 64;
+
+	static_assert(alignof(T) <= header_size, "mapped_swap_back_array elements cannot be aligned past the header size.");
+
+	/**
+	 * @brief How much of an existing file is checked when opening it.
+	 */
+	enum class open_check
+	{
+		header,  ///< The header only: O(1), the elements are not read. The next checksum update trusts them.
+		checksum ///< The header and the checksum of the elements.
+	};
+
+	/**
+	 * @brief Opens the file at path, or creates it empty if it does not exist.
+	 *
+	 * @param path The path of the file.
+	 * @param check How much of an existing file is checked.
+	 * @throws std::system_error if the file cannot be opened or mapped.
+	 * @throws std::runtime_error if the file is not a mapped_swap_back_array of T, or fails the check.
+	 */
+	explicit mapped_swap_back_array(const std::filesystem::path& path, open_check check = open_check::checksum);
+
+	mapped_swap_back_array(const mapped_swap_back_array&) = delete;
+	mapped_swap_back_array& operator=(const mapped_swap_back_array&) = delete;
+
+	mapped_swap_back_array(mapped_swap_back_array&& other) noexcept;
+	mapped_swap_back_array& operator=(mapped_swap_back_array&& other) noexcept;
+
+	/**
+	 * @brief Updates the checksum and unmaps the file.
+	 */
+	~mapped_swap_back_array();
+
+	/// Element access
+
+	[[nodiscard]] T& operator[](size_type index) noexcept { assert(index < size()); return data_[index]; }
+	[[nodiscard]] const T& operator[](size_type index) const noexcept { assert(index < size()); return data_[index]; }
+	[[nodiscard]] T& back() noexcept { assert(!empty()); return data_[size() - 1]; }
+	[[nodiscard]] const T& back() const noexcept { assert(!empty()); return data_[size() - 1]; }
+	[[nodiscard]] T* data() noexcept { return data_; }
+	[[nodiscard]] const T* data() const noexcept { return data_; }
+
+	/// Iterators
+
+	[[nodiscard]] iterator begin() noexcept { return data_; }
+	[[nodiscard]] iterator end() noexcept { return data_ + size(); }
+	[[nodiscard]] const_iterator begin() const noexcept { return data_; }
+	[[nodiscard]] const_iterator end() const noexcept { return data_ + size(); }
+
+	/// Capacity
+
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+	[[nodiscard]] size_type size() const noexcept;
+	[[nodiscard]] size_type capacity() const noexcept;
+
+	/**
+	 * @brief Grows the file to hold at least new_capacity elements.
+	 *
+	 * @note Invalidates pointers to the elements if the mapping moves.
+	 *
+	 * @param new_capacity The number of elements to reserve storage for.
+	 * @throws std::system_error if the file cannot be grown.
+	 */
+	void reserve(size_type new_capacity);
+
+	/// Modifiers
+
+	void clear() noexcept;
+	void push_back(const T& value) { emplace_back(value); }
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_back() noexcept;
+
+	/**
+	 * @brief Removes the element at the specified index by replacing it with the last element.
+	 *
+	 * @param element_index The index of the element to remove.
+	 */
+	void erase_swap(size_type element_index) noexcept;
+
+	/**
+	 * @brief Removes count elements from start_index, replacing them with the last elements, see swap_back_array.
+	 *
+	 * @param start_index The index of the first element to remove.
+	 * @param count The number of elements to remove.
+	 */
+	void erase_swap(size_type start_index, size_type count) noexcept;
+
+	/**
+	 * @brief Removes all elements satisfying pred, see swap_back_array::erase_swap_if.
+	 *
+	 * @param pred The predicate called on each element.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	size_type erase_swap_if(Pred pred);
+
+	/// Persistence
+
+	/**
+	 * @brief Updates the checksum and flushes the mapping to the file.
+	 *
+	 * @throws std::system_error if the mapping cannot be flushed.
+	 */
+	void sync();
+
+	/**
+	 * @brief Returns true if the checksum stored in the header matches the elements.
+	 * It matches after sync() until the next modification.
+	 */
+	[[nodiscard]] bool verify_checksum() const noexcept;
+
+private:
+
+	struct file_header
+	{
+		std::uint64_t magic;
+		std::uint32_t version;
+		std::uint32_t element_size;
+		std::uint64_t element_alignment;
+		std::uint64_t size;
+		std::uint64_t capacity;
+		std::uint64_t checksum;
+	};
+
+	static_assert(sizeof(file_header) <= header_size);
+
+	// identifies the file format
+	static constexpr std::uint64_t file_magic = 0x5354'4353'4241'3031;
+	static constexpr std::uint32_t file_version = 1;
+	static constexpr size_type default_capacity = 64;
+
+	file_header& header() noexcept { return *reinterpret_cast<file_header*>(mapping_); }
+	const file_header& header() const noexcept { return *reinterpret_cast<const file_header*>(mapping_); }
+
+	// Resizes the file and the mapping for capacity elements.
+	void remap(size_type capacity);
+
+	// Checks an existing file, throws std::runtime_error on mismatch.
+	void validate(size_type file_size, open_check check) const;
+
+	[[nodiscard]] std::uint64_t compute_checksum() const noexcept;
+
+	// Unmaps and closes the file, after updating the checksum.
+	void close() noexcept;
+
+	int fd_ = -1;
+	std::byte* mapping_ = nullptr;
+	size_type mapping_size_ = 0;
+	T* data_ = nullptr;
+};
+
+} // namespace stc
+
+#include "../../src/mapped_swap_back_array.inl"
@@ -0,0 +1,161 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief A memory resource handing out memory from large blocks, and releasing it all at once.
+ *
+ * Allocation bumps a pointer into the current block, and takes a new block from the global operator new when it
+ * is exhausted, each block being twice as large as the previous one. Deallocation does nothing, except for the most
+ * recent allocation which is rolled back, so that a growing container can reuse its previous buffer space.
+ * reset() makes all the memory available again at once. It keeps the largest block, and the next block is as large
+ * as all the released ones, so a workload repeating every frame settles in a single block after two frames.
+ *
+ * Use it with containers through arena_allocator.
+ *
+ * @note Not thread-safe, use one arena per thread.
+ */
+class monotonic_arena
+{
+public:
+
+	using size_type = std::size_t;
+
+	/**
+	 * @brief Size of the first block, when none is given to the constructor.
+	 */
+	static constexpr size_type default_block_size = 64 * 1024;
+
+	/**
+	 * @brief Constructs an empty arena, the first block is allocated on first use.
+	 *
+	 * @param initial_block_size The size in bytes of the first block.
+	 */
+	explicit monotonic_arena(size_type initial_block_size = default_block_size) noexcept;
+
+	monotonic_arena(const monotonic_arena&) = delete;
+	monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+	~monotonic_arena();
+
+	/**
+	 * @brief Allocates bytes of memory aligned to alignment.
+	 *
+	 * @note alignment must be a power of two.
+	 *
+	 * @param bytes The size of the allocation.
+	 * @param alignment The alignment of the allocation.
+	 * @return Pointer to the allocated memory.
+	 * @throws std::bad_alloc if a new block cannot be allocated.
+	 */
+	[[nodiscard]] void* allocate(size_type bytes, size_type alignment = alignof(std::max_align_t));
+
+	/**
+	 * @brief Releases memory, which is only reused if it is the most recent allocation.
+	 *
+	 * @param ptr Pointer returned by allocate.
+	 * @param bytes The size given to allocate.
+	 */
+	void deallocate(void* ptr, size_type bytes) noexcept;
+
+	/**
+	 * @brief Makes all the memory available again, invalidating every allocation.
+	 *
+	 * The largest block is kept for the next allocations, the others are returned to the global allocator.
+	 * If the kept block is exhausted, the next one is as large as all the blocks held before the reset.
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Returns every block to the global allocator, invalidating every allocation.
+	 */
+	void release() noexcept;
+
+	/**
+	 * @brief Total size in bytes of the blocks currently held.
+	 */
+	[[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+	/**
+	 * @brief Number of blocks requested from the global allocator since construction.
+	 */
+	[[nodiscard]] size_type upstream_allocations() const noexcept { return upstream_allocations_; }
+
+private:
+
+	// Header stored at the start of each block.
+	struct block
+	{
+		block* previous;
+		size_type size;
+	};
+
+	static constexpr size_type block_alignment = alignof(std::max_align_t);
+
+	// Allocates a block able to hold bytes aligned to alignment, and makes it current.
+	void add_block(size_type bytes, size_type alignment);
+
+	static void free_block(block* b) noexcept;
+
+	block* current_ = nullptr;
+	std::byte* cursor_ = nullptr;
+	std::byte* end_ = nullptr;
+	std::byte* last_allocation_ = nullptr;
+	size_type next_block_size_;
+	size_type capacity_ = 0;
+	size_type upstream_allocations_ = 0;
+};
+
+/**
+ * @brief A standard allocator drawing its memory from a monotonic_arena.
+ *
+ * Copies and rebound copies share the arena, and allocators compare equal when they share an arena.
+ * The arena must outlive every container using it. Containers release nothing to the arena in practice,
+ * the memory is reclaimed by monotonic_arena::reset().
+ *
+ * @tparam T Type of the allocated objects.
+ */
+template<typename T>
+class arena_allocator
+{
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using is_always_equal = std::false_type;
+
+	/**
+	 * @brief Constructs an allocator drawing from arena.
+	 *
+	 * @param arena The arena to allocate from.
+	 */
+	arena_allocator(monotonic_arena& arena) noexcept : arena_(&arena) {}
+
+	template<typename U>
+	arena_allocator(const arena_allocator<U>& other) noexcept : arena_(&other.arena()) {}
+
+	[[nodiscard]] T* allocate(size_type count);
+	void deallocate(T* ptr, size_type count) noexcept;
+
+	[[nodiscard]] monotonic_arena& arena() const noexcept { return *arena_; }
+
+private:
+
+	monotonic_arena* arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) noexcept
+{
+	return &a.arena() == &b.arena();
+}
+
+} // namespace stc
+
+#include "../../src/monotonic_arena.inl"
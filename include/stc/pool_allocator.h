@@ -0,0 +1,143 @@
+#pragma once
+#include "monotonic_arena.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief A memory resource recycling freed memory through free lists of power of two size classes.
+ *
+ * Each allocation is rounded up to a power of two size class. Freed memory goes to the free list of its class, where
+ * the next allocation of the same class takes it back in O(1). When a free list is empty, memory is carved from an
+ * internal monotonic_arena. Unlike the arena alone, memory freed by containers is reused during the frame, e.g. by
+ * arrays created and destroyed in a loop. reset() makes all the memory available again at once.
+ *
+ * Use it with containers through pool_allocator.
+ *
+ * @note Not thread-safe, use one pool per thread.
+ */
+class pool_resource
+{
+public:
+
+	using size_type = std::size_t;
+
+	/**
+	 * @brief Smallest size class, large enough to link free memory.
+	 */
+	static constexpr size_type min_block_size = 16;
+
+	/**
+	 * @brief Largest supported alignment. Blocks are aligned to their size, up to this value.
+	 */
+	static constexpr size_type max_alignment = 64;
+
+	/**
+	 * @brief Constructs an empty pool.
+	 *
+	 * @param initial_block_size The size in bytes of the first block of the underlying arena.
+	 */
+	explicit pool_resource(size_type initial_block_size = monotonic_arena::default_block_size) noexcept
+		: arena_(initial_block_size) {}
+
+	/**
+	 * @brief Allocates bytes of memory aligned to alignment, reusing freed memory of the same size class.
+	 *
+	 * @note alignment must be a power of two, up to max_alignment.
+	 *
+	 * @param bytes The size of the allocation.
+	 * @param alignment The alignment of the allocation.
+	 * @return Pointer to the allocated memory.
+	 * @throws std::bad_alloc if bytes exceeds the largest size class, or if the arena cannot grow.
+	 */
+	[[nodiscard]] void* allocate(size_type bytes, size_type alignment = alignof(std::max_align_t));
+
+	/**
+	 * @brief Gives memory back to the free list of its size class.
+	 *
+	 * @param ptr Pointer returned by allocate.
+	 * @param bytes The size given to allocate.
+	 * @param alignment The alignment given to allocate.
+	 */
+	void deallocate(void* ptr, size_type bytes, size_type alignment = alignof(std::max_align_t)) noexcept;
+
+	/**
+	 * @brief Makes all the memory available again, invalidating every allocation.
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Returns every block of the arena to the global allocator, invalidating every allocation.
+	 */
+	void release() noexcept;
+
+	/**
+	 * @brief Returns the underlying arena, e.g. for its statistics.
+	 */
+	[[nodiscard]] const monotonic_arena& arena() const noexcept { return arena_; }
+
+private:
+
+	struct free_block
+	{
+		free_block* next;
+	};
+
+	// Size class of an allocation: the index of its power of two size.
+	static size_type size_class(size_type bytes, size_type alignment) noexcept;
+
+	monotonic_arena arena_;
+	std::array<free_block*, sizeof(size_type) * 8> free_lists_{};
+};
+
+/**
+ * @brief A standard allocator drawing its memory from a pool_resource.
+ *
+ * Copies and rebound copies share the pool, and allocators compare equal when they share a pool.
+ * The pool must outlive every container using it.
+ *
+ * @tparam T Type of the allocated objects.
+ */
+template<typename T>
+class pool_allocator
+{
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using is_always_equal = std::false_type;
+
+	/**
+	 * @brief Constructs an allocator drawing from pool.
+	 *
+	 * @param pool The pool to allocate from.
+	 */
+	pool_allocator(pool_resource& pool) noexcept : pool_(&pool) {}
+
+	template<typename U>
+	pool_allocator(const pool_allocator<U>& other) noexcept : pool_(&other.pool()) {}
+
+	[[nodiscard]] T* allocate(size_type count);
+	void deallocate(T* ptr, size_type count) noexcept;
+
+	[[nodiscard]] pool_resource& pool() const noexcept { return *pool_; }
+
+private:
+
+	pool_resource* pool_;
+};
+
+template<typename T, typename U>
+bool operator==(const pool_allocator<T>& a, const pool_allocator<U>& b) noexcept
+{
+	return &a.pool() == &b.pool();
+}
+
+} // namespace stc
+
+#include "../../src/pool_allocator.inl"
@@ -0,0 +1,341 @@
+#pragma once
+#include "swap_partition.h"
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stc
+{
+
+/**
+ * @brief A swap_back_array storing its elements in fixed-size chunks, which never moves them to grow.
+ *
+ * Elements are stored in chunks of ChunkSize elements. Growing past the capacity allocates a single new chunk,
+ * instead of reallocating and moving every element like std::vector. This bounds the cost of emplace_back, and
+ * pointers and references to the elements stay valid until the element itself is removed or moved by an erase_swap.
+ * Indexed access is O(1): the chunk and the offset are a shift and a mask of the index.
+ *
+ * @note Elements are only contiguous within a chunk, see chunk() to process them as spans.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam ChunkSize Number of elements per chunk, a power of two (defaults to 1024).
+ * @tparam Allocator Allocator used for the chunks (defaults to std::allocator<T>).
+ */
+template<typename T, std::size_t ChunkSize = 1024, typename Allocator = std::allocator<T>>
+class segmented_swap_back_array
+{
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "segmented_swap_back_array needs a power of two chunk size.");
+
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+	template <bool Const>
+	class basic_iterator;
+
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	/**
+	 * @brief Number of elements per chunk.
+	 */
+	static constexpr size_type chunk_size = ChunkSize;
+
+	segmented_swap_back_array() noexcept(noexcept(Allocator())) = default;
+
+	/**
+	 * @brief Constructs an empty segmented_swap_back_array using the given allocator.
+	 *
+	 * @param alloc The allocator used for the chunks.
+	 */
+	explicit segmented_swap_back_array(const Allocator& alloc) noexcept;
+
+	/**
+	 * @brief Constructs a segmented_swap_back_array with count copies of value.
+	 *
+	 * @param count The number of elements.
+	 * @param value The value to copy.
+	 * @param alloc The allocator used for the chunks.
+	 */
+	segmented_swap_back_array(size_type count, const T& value, const Allocator& alloc = Allocator());
+
+	/**
+	 * @brief Constructs a segmented_swap_back_array from an initializer list.
+	 *
+	 * @param ilist The initializer list to copy from.
+	 * @param alloc The allocator used for the chunks.
+	 */
+	segmented_swap_back_array(std::initializer_list<T> ilist, const Allocator& alloc = Allocator());
+
+	/**
+	 * @brief Constructs a segmented_swap_back_array from another segmented_swap_back_array.
+	 *
+	 * @param other The segmented_swap_back_array to copy from.
+	 */
+	segmented_swap_back_array(const segmented_swap_back_array& other);
+
+	/**
+	 * @brief Constructs a segmented_swap_back_array by moving another segmented_swap_back_array.
+	 *
+	 * The chunks change hands, no element is moved.
+	 *
+	 * @param other The segmented_swap_back_array to move from, left empty.
+	 */
+	segmented_swap_back_array(segmented_swap_back_array&& other) noexcept;
+
+	~segmented_swap_back_array();
+
+	/**
+	 * @brief Copy assignment operator from another segmented_swap_back_array.
+	 *
+	 * @param other The segmented_swap_back_array to copy from.
+	 * @return Reference to this segmented_swap_back_array.
+	 */
+	segmented_swap_back_array& operator=(const segmented_swap_back_array& other);
+
+	/**
+	 * @brief Move assignment operator from another segmented_swap_back_array.
+	 *
+	 * @param other The segmented_swap_back_array to move from, left empty.
+	 * @return Reference to this segmented_swap_back_array.
+	 */
+	segmented_swap_back_array& operator=(segmented_swap_back_array&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value);
+
+	/**
+	 * @brief Assigns the contents of an initializer list to the segmented_swap_back_array.
+	 *
+	 * @param ilist The initializer list to assign from.
+	 * @return Reference to this segmented_swap_back_array.
+	 */
+	segmented_swap_back_array& operator=(std::initializer_list<T> ilist);
+
+	/// Element access
+
+	[[nodiscard]] T& operator[](size_type index) noexcept { assert(index < size_); return chunks_[index / ChunkSize][index % ChunkSize]; }
+	[[nodiscard]] const T& operator[](size_type index) const noexcept { assert(index < size_); return chunks_[index / ChunkSize][index % ChunkSize]; }
+	[[nodiscard]] T& at(size_type index);
+	[[nodiscard]] const T& at(size_type index) const;
+	[[nodiscard]] T& front() noexcept { assert(size_ > 0); return (*this)[0]; }
+	[[nodiscard]] const T& front() const noexcept { assert(size_ > 0); return (*this)[0]; }
+	[[nodiscard]] T& back() noexcept { assert(size_ > 0); return (*this)[size_ - 1]; }
+	[[nodiscard]] const T& back() const noexcept { assert(size_ > 0); return (*this)[size_ - 1]; }
+
+	/**
+	 * @brief Returns the elements stored in a chunk, which are contiguous.
+	 *
+	 * Processing the chunks one by one avoids computing the chunk of each element, e.g. in vectorizable loops.
+	 *
+	 * @param chunk_index The index of the chunk, below chunk_count().
+	 * @return std::span<T> The elements of the chunk, only the last non-empty chunk can be partially filled.
+	 */
+	[[nodiscard]] std::span<T> chunk(size_type chunk_index) noexcept;
+	[[nodiscard]] std::span<const T> chunk(size_type chunk_index) const noexcept;
+
+	/**
+	 * @brief Returns the number of chunks holding at least one element.
+	 */
+	[[nodiscard]] size_type chunk_count() const noexcept { return (size_ + ChunkSize - 1) / ChunkSize; }
+
+	/// Iterators
+
+	[[nodiscard]] iterator begin() noexcept { return {this, 0}; }
+	[[nodiscard]] iterator end() noexcept { return {this, size_}; }
+	[[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+	[[nodiscard]] const_iterator end() const noexcept { return {this, size_}; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return {this, 0}; }
+	[[nodiscard]] const_iterator cend() const noexcept { return {this, size_}; }
+
+	/// Capacity
+
+	[[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+	[[nodiscard]] size_type capacity() const noexcept { return chunks_.size() * ChunkSize; }
+
+	/**
+	 * @brief Allocates chunks until at least new_capacity elements fit. No element is moved.
+	 *
+	 * @param new_capacity The number of elements to reserve storage for.
+	 */
+	void reserve(size_type new_capacity);
+
+	/**
+	 * @brief Releases the chunks holding no element.
+	 */
+	void shrink_to_fit() noexcept;
+
+	/// Modifiers
+
+	void clear() noexcept;
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	/**
+	 * @brief Constructs an element at the end of the container.
+	 *
+	 * If the last chunk is full, a single chunk is allocated. Existing elements are never moved.
+	 *
+	 * @param args Arguments forwarded to the constructor of T.
+	 * @return Reference to the new element.
+	 */
+	template <typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_back() noexcept;
+	void resize(size_type count);
+	void resize(size_type count, const T& value);
+
+	[[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+	/// Swap back removal, see swap_back_array for the detailed contracts.
+
+	/**
+	 * @brief Removes an element at the specified index in O(1) time.
+	 *
+	 * @note The user must provide a valid index.
+	 * @note If the user is iterating over the container, the same index should be reused for the next iteration after each removal.
+	 *
+	 * @param element_index The index of the element to remove.
+	 */
+	void erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes a range of elements starting from the specified index in O(1) time per element.
+	 *
+	 * @note The user must provide a valid range (start_index + count <= container.size()).
+	 *
+	 * @param start_index The starting index of the range to remove.
+	 * @param count The number of elements to remove.
+	 */
+	void erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes an element at the specified iterator in O(1) time.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param it The iterator pointing to the element to remove.
+	 * @return it with an updated value, or end() if it was deleted.
+	 */
+	iterator erase_swap(const_iterator it) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes the elements in range [first, last) in O(1) time per element.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param first Iterator pointing to the first element to remove.
+	 * @param last Iterator pointing one past the last element to remove.
+	 * @return first with an updated value, or end() if first was deleted.
+	 */
+	iterator erase_swap(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes all elements satisfying a predicate in a single pass.
+	 *
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	size_type erase_swap_if(Pred pred);
+
+	/**
+	 * @brief Removes the elements in range [first, last) satisfying a predicate in a single pass.
+	 *
+	 * @param first Iterator pointing to the first element to test.
+	 * @param last Iterator pointing one past the last element to test.
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	size_type erase_swap_if(const_iterator first, const_iterator last, Pred pred);
+
+private:
+
+	// Destroys the last count elements, chunks are kept.
+	void destroy_back(size_type count) noexcept;
+
+	// Destroys the elements and releases every chunk.
+	void release() noexcept;
+
+	std::vector<T*> chunks_;
+	size_type size_ = 0;
+	[[no_unique_address]] Allocator alloc_;
+};
+
+/**
+ * @brief Random access iterator over a segmented_swap_back_array, holding an index.
+ */
+template<typename T, std::size_t ChunkSize, typename Allocator>
+template<bool Const>
+class segmented_swap_back_array<T, ChunkSize, Allocator>::basic_iterator
+{
+	using container = std::conditional_t<Const, const segmented_swap_back_array, segmented_swap_back_array>;
+
+public:
+
+	using iterator_concept = std::random_access_iterator_tag;
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = std::conditional_t<Const, const T*, T*>;
+	using reference = std::conditional_t<Const, const T&, T&>;
+
+	basic_iterator() noexcept = default;
+	basic_iterator(container* owner, size_type index) noexcept : owner_(owner), index_(index) {}
+
+	// Mutable iterators convert to const ones.
+	operator basic_iterator<true>() const noexcept requires (!Const) { return {owner_, index_}; }
+
+	[[nodiscard]] reference operator*() const noexcept { return (*owner_)[index_]; }
+	[[nodiscard]] pointer operator->() const noexcept { return &(*owner_)[index_]; }
+	[[nodiscard]] reference operator[](difference_type offset) const noexcept { return (*owner_)[index_ + offset]; }
+
+	/**
+	 * @brief Returns the index of the element the iterator points to.
+	 */
+	[[nodiscard]] size_type index() const noexcept { return index_; }
+
+	basic_iterator& operator++() noexcept { ++index_; return *this; }
+	basic_iterator operator++(int) noexcept { auto copy = *this; ++index_; return copy; }
+	basic_iterator& operator--() noexcept { --index_; return *this; }
+	basic_iterator operator--(int) noexcept { auto copy = *this; --index_; return copy; }
+	basic_iterator& operator+=(difference_type offset) noexcept { index_ += offset; return *this; }
+	basic_iterator& operator-=(difference_type offset) noexcept { index_ -= offset; return *this; }
+
+	[[nodiscard]] friend basic_iterator operator+(basic_iterator it, difference_type offset) noexcept { return it += offset; }
+	[[nodiscard]] friend basic_iterator operator+(difference_type offset, basic_iterator it) noexcept { return it += offset; }
+	[[nodiscard]] friend basic_iterator operator-(basic_iterator it, difference_type offset) noexcept { return it -= offset; }
+	[[nodiscard]] friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+	{
+		return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+	}
+
+	[[nodiscard]] friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.index_ == b.index_; }
+	[[nodiscard]] friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a.index_ <=> b.index_; }
+
+private:
+
+	container* owner_ = nullptr;
+	size_type index_ = 0;
+};
+
+} // namespace stc
+
+#include "../../src/segmented_swap_back_array.inl"
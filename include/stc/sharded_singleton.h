@@ -0,0 +1,145 @@
+#pragma once
+#include "interference_size.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace stc
+{
+
+/**
+ * @brief Singleton split in Shards instances, instantiated during static initialization.
+ *
+ * One logical instance for many writers: each thread writes to the shard of the CPU it runs on, and the shards
+ * are reduced when the whole value is needed. Each shard is padded to its own cache lines, so writers on
+ * different CPUs do not contend. Like eager_singleton, the shards live in static storage and are subject to the
+ * 'Static Initialization Order Fiasco'.
+ * @see https://en.cppreference.com/w/cpp/language/siof
+ *
+ * @note Threads migrate between CPUs, and several threads can share a shard: updates must be thread-safe, e.g.
+ * relaxed atomic operations, which stay cheap while the cache line is not shared.
+ * @note On Linux, shards are selected with sched_getcpu(). Elsewhere, threads are assigned shards in turn.
+ * @note It is recommended to use this class with the CRTP idiom to fully leverage the provided syntax.
+ *
+ * @tparam T The type of the shards.
+ * @tparam Shards The number of shards, ideally the number of CPUs, rounded up to a power of two.
+ */
+template <typename T, std::size_t Shards>
+class sharded_singleton
+{
+	static_assert(Shards > 0, "sharded_singleton needs at least one shard.");
+
+public:
+
+	/**
+	 * @brief Number of shards.
+	 */
+	static constexpr std::size_t shard_count = Shards;
+
+	/**
+	 * @brief Minimum alignment of the shards, the offset between two objects to avoid false sharing.
+	 */
+	static constexpr std::size_t shard_alignment = destructive_interference;
+
+	/**
+	 * @brief Retrieves the shard of the calling thread.
+	 *
+	 * @return T& Reference to the shard of the CPU the calling thread runs on.
+	 */
+	[[nodiscard]] static T& local() noexcept
+	{
+		return shards_<>[shard_index()].instance;
+	}
+
+	/**
+	 * @brief Retrieves a shard by index.
+	 *
+	 * @note The user must provide a valid index (index < shard_count).
+	 *
+	 * @param index The index of the shard.
+	 * @return T& Reference to the shard.
+	 */
+	[[nodiscard]] static T& shard(std::size_t index) noexcept
+	{
+		assert(index < Shards && "Shard index out of range.");
+		return shards_<>[index].instance;
+	}
+
+	/**
+	 * @brief Returns the index of the shard of the calling thread.
+	 */
+	[[nodiscard]] static std::size_t shard_index() noexcept
+	{
+#if defined(__linux__)
+		int cpu = sched_getcpu();
+		if (cpu >= 0) [[likely]]
+			return static_cast<std::size_t>(cpu) % Shards;
+#endif
+		thread_local std::size_t index = next_thread_.fetch_add(1, std::memory_order_relaxed) % Shards;
+		return index;
+	}
+
+	/**
+	 * @brief Calls f on every shard, in index order.
+	 *
+	 * @param f Callable invoked with a T& for each shard.
+	 */
+	template <typename F>
+	static void for_each_shard(F f)
+	{
+		for (auto& s : shards_<>)
+			f(s.instance);
+	}
+
+	/**
+	 * @brief Folds every shard into a single value, as std::accumulate would.
+	 *
+	 * @param init The initial value of the result.
+	 * @param op Callable invoked as op(R, const T&) for each shard, returning the next value of the result.
+	 * @return R The folded value.
+	 */
+	template <typename R, typename Op>
+	[[nodiscard]] static R reduce(R init, Op op)
+	{
+		for (const auto& s : shards_<>)
+			init = op(std::move(init), s.instance);
+		return init;
+	}
+
+protected:
+
+	// Enables construction of T.
+	sharded_singleton() = default;
+
+private:
+
+	// Disable copy and move semantics.
+	sharded_singleton(const sharded_singleton&) = delete;
+	sharded_singleton(sharded_singleton&&) = delete;
+	sharded_singleton& operator=(const sharded_singleton&) = delete;
+	sharded_singleton& operator=(sharded_singleton&&) = delete;
+
+	// A shard, padded to cache lines of its own.
+	template <typename U>
+	struct alignas(std::max(shard_alignment, alignof(U))) shard_storage
+	{
+		U instance;
+	};
+
+	// The eagerly instantiated shards. Templates, so that they are only instantiated by the member functions,
+	// once T is complete.
+	template <typename U = T>
+	static inline std::array<shard_storage<U>, Shards> shards_;
+
+	// Assigns shards to threads when the CPU is unknown.
+	static inline std::atomic<std::size_t> next_thread_ = 0;
+};
+
+} // namespace stc
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief Element types searched as raw integers: integral types except bool, and enumerations, of 1, 2, 4 or 8 bytes.
+ */
+template<typename T>
+concept simd_searchable = ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>)
+	&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+/**
+ * @brief Vectorized linear search of a value, selecting at runtime the widest instruction set of the processor.
+ *
+ * On x86-64, the kernels compare 16 (SSE2), 32 (AVX2) or 64 (AVX-512) bytes per instruction, four vectors
+ * per iteration. The instruction set is detected once, on the first search. Other platforms, and compilers
+ * without per-function target attributes or intrinsics, use the portable loop.
+ */
+class simd_search
+{
+public:
+
+	/**
+	 * @brief Instruction sets of the search kernels, from the narrowest to the widest.
+	 */
+	enum class level
+	{
+		portable,
+		sse2,
+		avx2,
+		avx512, // AVX-512 F and BW
+	};
+
+	/**
+	 * @brief Returns the widest instruction set supported by both the processor and the operating system.
+	 */
+	[[nodiscard]] static level supported_level() noexcept;
+
+	/**
+	 * @brief Finds the first element equal to value, with the kernel of supported_level().
+	 *
+	 * @param data The elements to search.
+	 * @param count The number of elements.
+	 * @param value The value to search for.
+	 * @return std::size_t Index of the first element equal to value, or count if there is none.
+	 */
+	template<simd_searchable T>
+	[[nodiscard]] static std::size_t find(const T* data, std::size_t count, T value) noexcept;
+
+	/**
+	 * @brief Finds the first element equal to value, with the kernel of a specific instruction set.
+	 *
+	 * @note The instruction set must be supported (kernel_level <= supported_level()).
+	 *
+	 * @param data The elements to search.
+	 * @param count The number of elements.
+	 * @param value The value to search for.
+	 * @param kernel_level The instruction set to use.
+	 * @return std::size_t Index of the first element equal to value, or count if there is none.
+	 */
+	template<simd_searchable T>
+	[[nodiscard]] static std::size_t find(const T* data, std::size_t count, T value, level kernel_level) noexcept;
+
+private:
+
+	static level detect_level() noexcept;
+
+	// Kernels comparing the bit patterns of the elements, one per instruction set.
+	template<typename T>
+	static std::size_t find_portable(const T* data, std::size_t count, T value) noexcept;
+	template<typename T>
+	static std::size_t find_sse2(const T* data, std::size_t count, T value) noexcept;
+	template<typename T>
+	static std::size_t find_avx2(const T* data, std::size_t count, T value) noexcept;
+	template<typename T>
+	static std::size_t find_avx512(const T* data, std::size_t count, T value) noexcept;
+
+	// Lane-wise comparisons of vectors of T. The SSE2 and AVX2 ones set every bit of the equal lanes,
+	// the AVX-512 one returns a bit per lane.
+	template<typename T, typename Vector>
+	static Vector equal_sse2(Vector a, Vector b) noexcept;
+	template<typename T, typename Vector>
+	static Vector equal_avx2(Vector a, Vector b) noexcept;
+	template<typename T, typename Vector>
+	static std::uint64_t equal_avx512(Vector a, Vector b) noexcept;
+};
+
+} // namespace stc
+
+#include "../../src/simd_search.inl"
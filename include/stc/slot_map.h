@@ -0,0 +1,180 @@
+#pragma once
+#include "swap_back_array.h"
+#include <cstdint>
+#include <limits>
+
+namespace stc
+{
+
+/**
+ * @brief Container giving stable handles to densely stored elements.
+ *
+ * Values live contiguously in a swap_back_array, so iteration is as fast as over a std::vector.
+ * Each value is referenced through a handle made of a slot index and a generation. The slot table
+ * maps handles to dense positions, and a reverse index maps dense positions back to slots so the
+ * table can be fixed up when erase_swap moves the last value into a hole.
+ * Insertion, removal and handle lookup are all O(1).
+ *
+ * @note Handles of erased elements are detected as stale, until a slot generation wraps around.
+ * @note Pointers and references to values are invalidated by insertion and removal, handles are not.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam Allocator Allocator used for memory management (defaults to std::allocator<T>).
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class slot_map
+{
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using generation_type = std::uint32_t;
+	using iterator = swap_back_array<T, Allocator>::iterator;
+	using const_iterator = swap_back_array<T, Allocator>::const_iterator;
+
+	/**
+	 * @brief Reference to an element of a slot_map, stable across insertions and removals.
+	 *
+	 * A default-constructed handle never refers to an element.
+	 */
+	struct handle
+	{
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		generation_type generation = 0;
+
+		constexpr bool operator==(const handle&) const = default;
+	};
+
+	constexpr slot_map() = default;
+
+	/**
+	 * @brief Constructs an empty slot_map using the given allocator.
+	 *
+	 * @param alloc The allocator used by the value and index arrays.
+	 */
+	constexpr explicit slot_map(const Allocator& alloc);
+
+	/**
+	 * @brief Constructs an element in place.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 * @return handle Handle to the new element.
+	 */
+	template <typename... Args>
+	constexpr handle emplace(Args&&... args);
+
+	/**
+	 * @brief Inserts a copy of an element.
+	 *
+	 * @param value The element to copy.
+	 * @return handle Handle to the new element.
+	 */
+	constexpr handle insert(const T& value) { return emplace(value); }
+
+	/**
+	 * @brief Inserts an element by moving it.
+	 *
+	 * @param value The element to move.
+	 * @return handle Handle to the new element.
+	 */
+	constexpr handle insert(T&& value) { return emplace(std::move(value)); }
+
+	/**
+	 * @brief Removes the element referenced by a handle in O(1) time.
+	 *
+	 * The last element is moved into the freed position, its handle stays valid.
+	 *
+	 * @note The type T must be move-assignable in order to use this method.
+	 *
+	 * @param h Handle of the element to remove.
+	 * @return bool True if an element was removed, false if the handle was stale.
+	 */
+	constexpr bool erase(handle h);
+
+	/**
+	 * @brief Checks whether a handle refers to a live element.
+	 *
+	 * @param h The handle to check.
+	 * @return bool True if the handle is valid, false otherwise.
+	 */
+	[[nodiscard]] constexpr bool contains(handle h) const noexcept;
+
+	/**
+	 * @brief Retrieves the element referenced by a handle.
+	 *
+	 * @param h The handle to look up.
+	 * @return Pointer to the element, or nullptr if the handle is stale.
+	 */
+	[[nodiscard]] constexpr T* find(handle h) noexcept;
+	[[nodiscard]] constexpr const T* find(handle h) const noexcept;
+
+	/**
+	 * @brief Retrieves the element referenced by a handle.
+	 *
+	 * @note Calling this function with a stale handle is undefined behavior.
+	 *
+	 * @param h The handle to look up.
+	 * @return Reference to the element.
+	 */
+	[[nodiscard]] constexpr T& operator[](handle h) noexcept;
+	[[nodiscard]] constexpr const T& operator[](handle h) const noexcept;
+
+	/**
+	 * @brief Retrieves the handle of the element at a dense position.
+	 *
+	 * @note The user must provide a valid index (dense_index < size()).
+	 *
+	 * @param dense_index Position of the element in iteration order.
+	 * @return handle Handle to the element.
+	 */
+	[[nodiscard]] constexpr handle handle_at(size_type dense_index) const noexcept;
+
+	/**
+	 * @brief Removes all elements. Every handle issued so far becomes stale.
+	 */
+	constexpr void clear() noexcept;
+
+	/**
+	 * @brief Reserves storage for at least new_capacity elements.
+	 *
+	 * @param new_capacity The number of elements to reserve storage for.
+	 */
+	constexpr void reserve(size_type new_capacity);
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return values_.size(); }
+	[[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+
+	[[nodiscard]] constexpr T* data() noexcept { return values_.data(); }
+	[[nodiscard]] constexpr const T* data() const noexcept { return values_.data(); }
+
+	[[nodiscard]] constexpr iterator begin() noexcept { return values_.begin(); }
+	[[nodiscard]] constexpr iterator end() noexcept { return values_.end(); }
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return values_.begin(); }
+	[[nodiscard]] constexpr const_iterator end() const noexcept { return values_.end(); }
+
+private:
+
+	// While occupied, index is the dense position of the value.
+	// While free, index is the next free slot.
+	struct slot
+	{
+		std::uint32_t index;
+		generation_type generation;
+	};
+
+	using slot_allocator = std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+	using index_allocator = std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>;
+
+	static constexpr std::uint32_t no_free_slot = std::numeric_limits<std::uint32_t>::max();
+
+	swap_back_array<T, Allocator> values_;
+	swap_back_array<std::uint32_t, index_allocator> dense_to_slot_;
+	std::vector<slot, slot_allocator> slots_;
+	std::uint32_t free_head_ = no_free_slot;
+};
+
+} // namespace stc
+
+#include "../../src/slot_map.inl"
@@ -0,0 +1,284 @@
+#pragma once
+#include "swap_partition.h"
+#include "trivially_relocatable.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace stc
+{
+
+/**
+ * @brief A swap_back_array keeping up to N elements inline, without heap allocation.
+ *
+ * Elements are stored in a buffer embedded in the object until the size grows past N, at which point
+ * they are moved to storage obtained from the allocator. The interface follows std::vector for the common
+ * operations, and the erase_swap family has the same overloads and semantics as swap_back_array.
+ *
+ * @note Unlike std::vector, moving an inline small_swap_back_array moves its elements one by one.
+ * @note Growth and range removal relocate trivially relocatable elements as blocks, see is_trivially_relocatable.
+ * With a reallocating_allocator, heap buffers of such elements are resized by the allocator, e.g. with mremap.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam N Number of elements stored inline.
+ * @tparam Allocator Allocator used once the inline capacity is exceeded (defaults to std::allocator<T>).
+ */
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_swap_back_array
+{
+	static_assert(N > 0, "small_swap_back_array needs an inline capacity of at least one element.");
+
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	/**
+	 * @brief Number of elements stored without allocating.
+	 */
+	static constexpr size_type inline_capacity = N;
+
+	small_swap_back_array() noexcept(noexcept(Allocator())) = default;
+
+	/**
+	 * @brief Constructs an empty small_swap_back_array using the given allocator.
+	 *
+	 * @param alloc The allocator used once the inline capacity is exceeded.
+	 */
+	explicit small_swap_back_array(const Allocator& alloc) noexcept;
+
+	/**
+	 * @brief Constructs a small_swap_back_array with count copies of value.
+	 *
+	 * @param count The number of elements.
+	 * @param value The value to copy.
+	 * @param alloc The allocator used once the inline capacity is exceeded.
+	 */
+	small_swap_back_array(size_type count, const T& value, const Allocator& alloc = Allocator());
+
+	/**
+	 * @brief Constructs a small_swap_back_array from an initializer list.
+	 *
+	 * @param ilist The initializer list to copy from.
+	 * @param alloc The allocator used once the inline capacity is exceeded.
+	 */
+	small_swap_back_array(std::initializer_list<T> ilist, const Allocator& alloc = Allocator());
+
+	/**
+	 * @brief Constructs a small_swap_back_array from another small_swap_back_array.
+	 *
+	 * @param other The small_swap_back_array to copy from.
+	 */
+	small_swap_back_array(const small_swap_back_array& other);
+
+	/**
+	 * @brief Constructs a small_swap_back_array by moving another small_swap_back_array.
+	 *
+	 * Heap storage is stolen, inline elements are moved one by one.
+	 *
+	 * @param other The small_swap_back_array to move from, left empty.
+	 */
+	small_swap_back_array(small_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	~small_swap_back_array();
+
+	/**
+	 * @brief Copy assignment operator from another small_swap_back_array.
+	 *
+	 * @param other The small_swap_back_array to copy from.
+	 * @return Reference to this small_swap_back_array.
+	 */
+	small_swap_back_array& operator=(const small_swap_back_array& other);
+
+	/**
+	 * @brief Move assignment operator from another small_swap_back_array.
+	 *
+	 * @note Not noexcept with an unequal allocator that does not propagate, as the elements are then moved into
+	 * storage allocated by this array.
+	 *
+	 * @param other The small_swap_back_array to move from, left empty.
+	 * @return Reference to this small_swap_back_array.
+	 */
+	small_swap_back_array& operator=(small_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value));
+
+	/**
+	 * @brief Assigns the contents of an initializer list to the small_swap_back_array.
+	 *
+	 * @param ilist The initializer list to assign from.
+	 * @return Reference to this small_swap_back_array.
+	 */
+	small_swap_back_array& operator=(std::initializer_list<T> ilist);
+
+	/// Element access
+
+	[[nodiscard]] T& operator[](size_type index) noexcept { assert(index < size_); return data_[index]; }
+	[[nodiscard]] const T& operator[](size_type index) const noexcept { assert(index < size_); return data_[index]; }
+	[[nodiscard]] T& at(size_type index);
+	[[nodiscard]] const T& at(size_type index) const;
+	[[nodiscard]] T& front() noexcept { assert(size_ > 0); return data_[0]; }
+	[[nodiscard]] const T& front() const noexcept { assert(size_ > 0); return data_[0]; }
+	[[nodiscard]] T& back() noexcept { assert(size_ > 0); return data_[size_ - 1]; }
+	[[nodiscard]] const T& back() const noexcept { assert(size_ > 0); return data_[size_ - 1]; }
+	[[nodiscard]] T* data() noexcept { return data_; }
+	[[nodiscard]] const T* data() const noexcept { return data_; }
+
+	/// Iterators
+
+	[[nodiscard]] iterator begin() noexcept { return data_; }
+	[[nodiscard]] iterator end() noexcept { return data_ + size_; }
+	[[nodiscard]] const_iterator begin() const noexcept { return data_; }
+	[[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return data_; }
+	[[nodiscard]] const_iterator cend() const noexcept { return data_ + size_; }
+
+	/// Capacity
+
+	[[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+	[[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+	/**
+	 * @brief Checks whether the elements are stored in the inline buffer.
+	 *
+	 * @return bool True if no heap storage is in use, false otherwise.
+	 */
+	[[nodiscard]] bool is_inline() const noexcept { return data_ == inline_data(); }
+
+	/**
+	 * @brief Reserves storage for at least new_capacity elements, moving to the heap if it exceeds N.
+	 *
+	 * @param new_capacity The number of elements to reserve storage for.
+	 */
+	void reserve(size_type new_capacity);
+
+	/**
+	 * @brief Releases unused heap storage, moving the elements back inline when they fit.
+	 */
+	void shrink_to_fit();
+
+	/// Modifiers
+
+	void clear() noexcept;
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_back() noexcept;
+	void resize(size_type count);
+	void resize(size_type count, const T& value);
+
+	[[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+	/// Swap back removal, see swap_back_array for the detailed contracts.
+	/// Iterator overloads are templates so that erase_swap(0) selects the index overload.
+
+	/**
+	 * @brief Removes an element at the specified index in O(1) time.
+	 *
+	 * @note The user must provide a valid index.
+	 * @note If the user is iterating over the container, the same index should be reused for the next iteration after each removal.
+	 *
+	 * @param element_index The index of the element to remove.
+	 */
+	void erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes a range of elements starting from the specified index in O(1) time per element.
+	 *
+	 * @note The user must provide a valid range (start_index + count <= container.size()).
+	 *
+	 * @param start_index The starting index of the range to remove.
+	 * @param count The number of elements to remove.
+	 */
+	void erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes an element at the specified iterator in O(1) time.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param it The iterator pointing to the element to remove.
+	 * @return it with an updated value, or end() if it was deleted.
+	 */
+	template <std::same_as<iterator> It>
+	iterator erase_swap(It it) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes the elements in range [first, last) in O(1) time per element.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param first Iterator pointing to the first element to remove.
+	 * @param last Iterator pointing one past the last element to remove.
+	 * @return first with an updated value, or end() if first was deleted.
+	 */
+	template <std::same_as<iterator> It>
+	iterator erase_swap(It first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes all elements satisfying a predicate in a single pass.
+	 *
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	size_type erase_swap_if(Pred pred);
+
+	/**
+	 * @brief Removes the elements in range [first, last) satisfying a predicate in a single pass.
+	 *
+	 * @param first Iterator pointing to the first element to test.
+	 * @param last Iterator pointing one past the last element to test.
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	size_type erase_swap_if(iterator first, const_iterator last, Pred pred);
+
+private:
+
+	T* inline_data() noexcept { return reinterpret_cast<T*>(inline_storage_); }
+	const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_storage_); }
+
+	// Destroys the last count elements.
+	void destroy_back(size_type count) noexcept;
+
+	// Moves the elements to a buffer of new_capacity elements, new_capacity must be >= size().
+	void reallocate(size_type new_capacity);
+
+	// Relocates the elements to new_data, leaving none alive in the current buffer (size_ is unchanged).
+	// Trivially relocatable elements are copied as a block.
+	void relocate_to(T* new_data);
+
+	// Releases the heap buffer if any, elements must already be destroyed.
+	void deallocate() noexcept;
+
+	// Takes the elements of other, which is left empty.
+	void steal(small_swap_back_array& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	T* data_ = inline_data();
+	size_type size_ = 0;
+	size_type capacity_ = N;
+	[[no_unique_address]] Allocator alloc_;
+	alignas(T) std::byte inline_storage_[N * sizeof(T)];
+};
+
+} // namespace stc
+
+#include "../../src/small_swap_back_array.inl"
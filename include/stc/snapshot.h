@@ -0,0 +1,68 @@
+#pragma once
+#include "swap_back_array.h"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+namespace stc
+{
+
+/**
+ * @brief Customization point serializing the elements of a snapshot that are not trivially copyable.
+ *
+ * Specialize it with two static functions:
+ * - void write(std::ostream& out, const T& value), writing one element;
+ * - T read(std::istream& in), returning the element read. The result initializes the element in the reserved
+ *   storage of the container, without a default construction.
+ *
+ * Trivially copyable types need no specialization, they are copied as raw bytes.
+ *
+ * @tparam T Type of the serialized elements.
+ */
+template<typename T>
+struct snapshot_traits;
+
+/**
+ * @brief Types that can be written to and read from a snapshot.
+ */
+template<typename T>
+concept snapshot_serializable = std::is_trivially_copyable_v<T> || requires(std::ostream& out, std::istream& in, const T& value)
+{
+	snapshot_traits<T>::write(out, value);
+	{ snapshot_traits<T>::read(in) } -> std::same_as<T>;
+};
+
+/**
+ * @brief Writes the elements of sba to out, in a binary format read back by read_snapshot.
+ *
+ * Trivially copyable elements are written as a single block of bytes, other elements one by one through
+ * snapshot_traits. The snapshot has a small header with the element count, and is not portable across
+ * platforms with different endianness or type layouts.
+ *
+ * @param out The stream to write to, opened in binary mode.
+ * @param sba The elements to write.
+ * @throws std::runtime_error if the stream fails.
+ */
+template<snapshot_serializable T, typename Allocator, shrink_policy ShrinkPolicy>
+void write_snapshot(std::ostream& out, const swap_back_array<T, Allocator, ShrinkPolicy>& sba);
+
+/**
+ * @brief Replaces the elements of sba with the ones of a snapshot written by write_snapshot.
+ *
+ * The storage is reserved once, then elements are constructed directly in it, without default construction.
+ * Trivially copyable elements are read in blocks small enough to stay in cache, then copied into it.
+ *
+ * @param in The stream to read from, opened in binary mode.
+ * @param sba The container receiving the elements.
+ * @throws std::runtime_error if the snapshot does not hold elements of type T, or the stream ends early.
+ * sba is left with the elements read so far.
+ */
+template<snapshot_serializable T, typename Allocator, shrink_policy ShrinkPolicy>
+void read_snapshot(std::istream& in, swap_back_array<T, Allocator, ShrinkPolicy>& sba);
+
+} // namespace stc
+
+#include "../../src/snapshot.inl"
@@ -0,0 +1,135 @@
+#pragma once
+#include "swap_back_array.h"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace stc
+{
+
+/**
+ * @brief Set of integer keys with O(1) insertion, removal and lookup, and dense iteration.
+ *
+ * Keys are stored contiguously in a swap_back_array, so iteration is as fast as over a std::vector. A sparse
+ * array maps each key to its dense position, and is fixed up when erase_swap moves the last key into a hole.
+ * The sparse array is split in pages of PageSize positions, allocated on the first insertion of one of their
+ * keys: memory follows the ranges of keys in use, not the largest key.
+ *
+ * @note Iteration order is insertion order until the first removal, which moves the last key.
+ * @note Pointers and iterators to the keys are invalidated by insertion and removal.
+ *
+ * @tparam Index Unsigned integer type of the keys, also used for the dense positions.
+ * @tparam PageSize Number of keys per sparse page, a power of two (defaults to 4096).
+ * @tparam Allocator Allocator used for the dense keys and the sparse pages (defaults to std::allocator<Index>).
+ */
+template<std::unsigned_integral Index = std::uint32_t, std::size_t PageSize = 4096, typename Allocator = std::allocator<Index>>
+class sparse_set
+{
+	static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "sparse_set needs a power of two page size.");
+
+public:
+
+	using key_type = Index;
+	using value_type = Index;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using iterator = swap_back_array<Index, Allocator>::const_iterator;
+	using const_iterator = swap_back_array<Index, Allocator>::const_iterator;
+
+	/**
+	 * @brief Number of keys per sparse page.
+	 */
+	static constexpr size_type page_size = PageSize;
+
+	/**
+	 * @brief Largest key of the set. The maximum value of Index marks absent keys.
+	 */
+	static constexpr Index max_key = std::numeric_limits<Index>::max() - 1;
+
+	constexpr sparse_set() = default;
+
+	/**
+	 * @brief Constructs an empty sparse_set using the given allocator.
+	 *
+	 * @param alloc The allocator used by the dense keys and the sparse pages.
+	 */
+	constexpr explicit sparse_set(const Allocator& alloc);
+
+	/**
+	 * @brief Inserts a key, if it is not in the set yet.
+	 *
+	 * @note The user must provide a valid key (key <= max_key).
+	 *
+	 * @param key The key to insert.
+	 * @return bool True if the key was inserted, false if it was already in the set.
+	 */
+	constexpr bool insert(Index key);
+
+	/**
+	 * @brief Removes a key in O(1) time. The last key is moved into its dense position.
+	 *
+	 * @param key The key to remove.
+	 * @return bool True if the key was removed, false if it was not in the set.
+	 */
+	constexpr bool erase(Index key) noexcept;
+
+	/**
+	 * @brief Checks whether a key is in the set.
+	 *
+	 * @param key The key to look up.
+	 * @return bool True if the key is in the set, false otherwise.
+	 */
+	[[nodiscard]] constexpr bool contains(Index key) const noexcept;
+
+	/**
+	 * @brief Retrieves the dense position of a key, its index in data().
+	 *
+	 * @param key The key to look up.
+	 * @return size_type Position of the key, or size() if it is not in the set.
+	 */
+	[[nodiscard]] constexpr size_type position(Index key) const noexcept;
+
+	/**
+	 * @brief Removes all keys. The sparse pages are kept for the next insertions.
+	 */
+	constexpr void clear() noexcept;
+
+	/**
+	 * @brief Reserves storage for at least new_capacity keys. The sparse pages are allocated by insertions.
+	 *
+	 * @param new_capacity The number of keys to reserve storage for.
+	 */
+	constexpr void reserve(size_type new_capacity);
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return dense_.size(); }
+	[[nodiscard]] constexpr bool empty() const noexcept { return dense_.empty(); }
+
+	/**
+	 * @brief Returns the number of allocated sparse pages.
+	 */
+	[[nodiscard]] constexpr size_type page_count() const noexcept;
+
+	[[nodiscard]] constexpr const Index* data() const noexcept { return dense_.data(); }
+
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return dense_.begin(); }
+	[[nodiscard]] constexpr const_iterator end() const noexcept { return dense_.end(); }
+
+private:
+
+	using page = std::vector<Index, Allocator>;
+	using page_allocator = std::allocator_traits<Allocator>::template rebind_alloc<page>;
+
+	// Sparse entry of the absent keys.
+	static constexpr Index absent = std::numeric_limits<Index>::max();
+
+	swap_back_array<Index, Allocator> dense_;
+	// Dense position of each key, or absent. Pages never used are empty.
+	std::vector<page, page_allocator> pages_;
+};
+
+} // namespace stc
+
+#include "../../src/sparse_set.inl"
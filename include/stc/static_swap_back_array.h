@@ -0,0 +1,278 @@
+#pragma once
+#include "swap_partition.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace stc
+{
+
+/**
+ * @brief A fixed-capacity swap_back_array that never allocates.
+ *
+ * Elements are stored in an uninitialized buffer of Capacity elements embedded in the object. Growing past
+ * Capacity is a precondition violation for emplace_back, while try_emplace_back reports it by returning nullptr.
+ * The violation asserts, and throws std::length_error when assertions are disabled, so that it never writes past
+ * the storage. In constant evaluation, it does not compile.
+ * Every member function is constexpr. For trivial types, the container itself is trivially copyable and can be
+ * returned from a constexpr function into a constexpr variable, e.g. to build lookup tables at compile time.
+ * Other types can be used in constant evaluation as long as the container does not outlive it.
+ *
+ * @note In constant evaluation, the storage of trivial types is value-initialized, as reading uninitialized
+ * objects is not allowed there. At runtime, it is left uninitialized.
+ *
+ * @tparam T Type of elements stored in the container.
+ * @tparam Capacity Maximum number of elements.
+ */
+template<typename T, std::size_t Capacity>
+class static_swap_back_array
+{
+	static_assert(Capacity > 0, "static_swap_back_array needs a capacity of at least one element.");
+
+	static constexpr bool trivial = std::is_trivially_default_constructible_v<T>
+		&& std::is_trivially_copyable_v<T>
+		&& std::is_trivially_destructible_v<T>;
+
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	constexpr static_swap_back_array() noexcept = default;
+
+	/**
+	 * @brief Constructs a static_swap_back_array with count copies of value.
+	 *
+	 * @note The user must provide a count that fits (count <= Capacity).
+	 *
+	 * @param count The number of elements.
+	 * @param value The value to copy.
+	 * @throws std::length_error if count > Capacity, when assertions are disabled.
+	 */
+	constexpr static_swap_back_array(size_type count, const T& value);
+
+	/**
+	 * @brief Constructs a static_swap_back_array from an initializer list.
+	 *
+	 * @note The user must provide a list that fits (ilist.size() <= Capacity).
+	 *
+	 * @param ilist The initializer list to copy from.
+	 * @throws std::length_error if ilist.size() > Capacity, when assertions are disabled.
+	 */
+	constexpr static_swap_back_array(std::initializer_list<T> ilist);
+
+	constexpr static_swap_back_array(const static_swap_back_array& other) requires trivial = default;
+	constexpr static_swap_back_array(const static_swap_back_array& other) noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+	constexpr static_swap_back_array(static_swap_back_array&& other) requires trivial = default;
+	constexpr static_swap_back_array(static_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	constexpr static_swap_back_array& operator=(const static_swap_back_array& other) requires trivial = default;
+	constexpr static_swap_back_array& operator=(const static_swap_back_array& other) noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+	constexpr static_swap_back_array& operator=(static_swap_back_array&& other) requires trivial = default;
+	constexpr static_swap_back_array& operator=(static_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	constexpr ~static_swap_back_array() requires std::is_trivially_destructible_v<T> = default;
+	constexpr ~static_swap_back_array() { clear(); }
+
+	/// Element access
+
+	[[nodiscard]] constexpr T& operator[](size_type index) noexcept { assert(index < size_); return storage_.data[index]; }
+	[[nodiscard]] constexpr const T& operator[](size_type index) const noexcept { assert(index < size_); return storage_.data[index]; }
+	[[nodiscard]] constexpr T& at(size_type index);
+	[[nodiscard]] constexpr const T& at(size_type index) const;
+	[[nodiscard]] constexpr T& front() noexcept { assert(size_ > 0); return storage_.data[0]; }
+	[[nodiscard]] constexpr const T& front() const noexcept { assert(size_ > 0); return storage_.data[0]; }
+	[[nodiscard]] constexpr T& back() noexcept { assert(size_ > 0); return storage_.data[size_ - 1]; }
+	[[nodiscard]] constexpr const T& back() const noexcept { assert(size_ > 0); return storage_.data[size_ - 1]; }
+	[[nodiscard]] constexpr T* data() noexcept { return storage_.data; }
+	[[nodiscard]] constexpr const T* data() const noexcept { return storage_.data; }
+
+	/// Iterators
+
+	[[nodiscard]] constexpr iterator begin() noexcept { return data(); }
+	[[nodiscard]] constexpr iterator end() noexcept { return data() + size_; }
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return data(); }
+	[[nodiscard]] constexpr const_iterator end() const noexcept { return data() + size_; }
+	[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data(); }
+	[[nodiscard]] constexpr const_iterator cend() const noexcept { return data() + size_; }
+
+	/// Capacity
+
+	[[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+	[[nodiscard]] constexpr bool full() const noexcept { return size_ == Capacity; }
+	[[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+	[[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
+	[[nodiscard]] static constexpr size_type max_size() noexcept { return Capacity; }
+
+	/// Modifiers
+
+	constexpr void clear() noexcept;
+
+	/**
+	 * @brief Constructs an element at the end.
+	 *
+	 * @note The container must not be full.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 * @return T& Reference to the new element.
+	 * @throws std::length_error if the container is full, when assertions are disabled.
+	 */
+	template <typename... Args>
+	constexpr T& emplace_back(Args&&... args);
+
+	constexpr void push_back(const T& value) { emplace_back(value); }
+	constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	/**
+	 * @brief Constructs an element at the end if there is room for it.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 * @return T* Pointer to the new element, or nullptr if the container is full.
+	 */
+	template <typename... Args>
+	constexpr T* try_emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>);
+
+	constexpr T* try_push_back(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) { return try_emplace_back(value); }
+	constexpr T* try_push_back(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) { return try_emplace_back(std::move(value)); }
+
+	constexpr void pop_back() noexcept;
+
+	/**
+	 * @brief Resizes the container, value-initializing new elements.
+	 *
+	 * @note The user must provide a count that fits (count <= Capacity).
+	 *
+	 * @param count The new size.
+	 * @throws std::length_error if count > Capacity, when assertions are disabled.
+	 */
+	constexpr void resize(size_type count);
+	constexpr void resize(size_type count, const T& value);
+
+	/// Swap back removal, see swap_back_array for the detailed contracts.
+	/// Iterator overloads are templates so that erase_swap(0) selects the index overload.
+
+	/**
+	 * @brief Removes an element at the specified index in O(1) time.
+	 *
+	 * @note The user must provide a valid index.
+	 * @note If the user is iterating over the container, the same index should be reused for the next iteration after each removal.
+	 *
+	 * @param element_index The index of the element to remove.
+	 */
+	constexpr void erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes a range of elements starting from the specified index in O(1) time per element.
+	 *
+	 * @note The user must provide a valid range (start_index + count <= container.size()).
+	 *
+	 * @param start_index The starting index of the range to remove.
+	 * @param count The number of elements to remove.
+	 */
+	constexpr void erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes an element at the specified iterator in O(1) time.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param it The iterator pointing to the element to remove.
+	 * @return it with an updated value, or end() if it was deleted.
+	 */
+	template <std::same_as<iterator> It>
+	constexpr iterator erase_swap(It it) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes the elements in range [first, last) in O(1) time per element.
+	 *
+	 * @note If iterating over the container, use the returned iterator to safely continue iteration.
+	 *
+	 * @param first Iterator pointing to the first element to remove.
+	 * @param last Iterator pointing one past the last element to remove.
+	 * @return first with an updated value, or end() if first was deleted.
+	 */
+	template <std::same_as<iterator> It>
+	constexpr iterator erase_swap(It first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes all elements satisfying a predicate in a single pass.
+	 *
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	constexpr size_type erase_swap_if(Pred pred);
+
+	/**
+	 * @brief Removes the elements in range [first, last) satisfying a predicate in a single pass.
+	 *
+	 * @param first Iterator pointing to the first element to test.
+	 * @param last Iterator pointing one past the last element to test.
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	constexpr size_type erase_swap_if(iterator first, const_iterator last, Pred pred);
+
+private:
+
+	// Plain array, only initialized in constant evaluation.
+	struct trivial_storage
+	{
+		constexpr trivial_storage() noexcept
+		{
+			if (std::is_constant_evaluated())
+			{
+				for (auto& value : data)
+					std::construct_at(&value);
+			}
+		}
+
+		T data[Capacity];
+	};
+
+	// Elements are constructed and destroyed by the container.
+	struct union_storage
+	{
+		constexpr union_storage() noexcept { /* Leave data uninitialized. */ }
+		constexpr ~union_storage() {}
+
+		union
+		{
+			T data[Capacity];
+		};
+	};
+
+	// Asserts that count elements fit, and throws std::length_error if they do not when assertions are disabled.
+	static constexpr void check_capacity(size_type count);
+
+	// Constructs an element at the end, the container must not be full.
+	template <typename... Args>
+	constexpr T& construct_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>);
+
+	// Destroys the last count elements.
+	constexpr void destroy_back(size_type count) noexcept;
+
+	std::conditional_t<trivial, trivial_storage, union_storage> storage_;
+	size_type size_ = 0;
+};
+
+} // namespace stc
+
+#include "../../src/static_swap_back_array.inl"
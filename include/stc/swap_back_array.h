@@ -1,10 +1,77 @@
 #pragma once
+#include "simd_search.h"
+#include "swap_partition.h"
+#include "trivially_relocatable.h"
 #include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace stc
 {
 
+template<typename T, typename Allocator>
+class concurrent_swap_back_array;
+
+/**
+ * @brief Records an element moved by an erase_swap operation, from its old index to its new one.
+ *
+ * Structures storing indices into the container can use these records to update themselves after a removal.
+ */
+struct relocation
+{
+	std::size_t from;
+	std::size_t to;
+
+	constexpr bool operator==(const relocation&) const = default;
+};
+
+/**
+ * @brief Shrink policy never reducing the capacity on removal, like std::vector. The default policy.
+ */
+struct never_shrink
+{
+	static constexpr std::size_t shrunk_capacity(std::size_t, std::size_t capacity) noexcept { return capacity; }
+};
+
+/**
+ * @brief Shrink policy halving the capacity whenever the size drops below capacity / Divisor.
+ *
+ * Growth doubles the capacity when the array is full, so after a halving the size must double again before the next
+ * reallocation. This hysteresis keeps the amortized cost of a removal O(1), even when the size oscillates.
+ *
+ * @tparam Divisor The capacity is halved while the size is below capacity / Divisor, it must be greater than 2.
+ * @tparam MinCapacity The capacity is never reduced below this number of elements.
+ */
+template<std::size_t Divisor = 4, std::size_t MinCapacity = 64>
+struct shrink_by_half
+{
+	static_assert(Divisor > 2, "shrink_by_half needs a divisor greater than 2, or growth and shrinking could alternate.");
+
+	static constexpr std::size_t shrunk_capacity(std::size_t size, std::size_t capacity) noexcept
+	{
+		// several halvings at once after a large removal
+		while (capacity / 2 >= MinCapacity && size < capacity / Divisor)
+			capacity /= 2;
+		return capacity;
+	}
+};
+
+/**
+ * @brief Policies deciding the capacity of a swap_back_array after a removal.
+ *
+ * shrunk_capacity(size, capacity) returns the new capacity, at least size. Returning capacity keeps the buffer.
+ */
+template<typename Policy>
+concept shrink_policy = requires(std::size_t size, std::size_t capacity)
+{
+	{ Policy::shrunk_capacity(size, capacity) } noexcept -> std::convertible_to<std::size_t>;
+};
+
 /**
  * @brief An extension of std::vector providing fast O(1) removal at any index.
  *
@@ -12,14 +79,31 @@ namespace stc
  * it with the last element before removal. This operation sacrifices the order of elements as a trade-off
  * for improved performance.
  *
+ * The erase_swap family applies ShrinkPolicy after each removal, to give back the capacity left by bursts.
+ * With a shrinking policy, a removal may reallocate and invalidate pointers to the remaining elements.
+ * The capacity is kept when shrinking could lose elements, i.e. for move-only T with a throwing move constructor.
+ *
  * @tparam T Type of elements stored in the container.
  * @tparam Allocator Allocator used for memory management (defaults to std::allocator<T>).
+ * @tparam ShrinkPolicy Policy reducing the capacity after removals (defaults to never_shrink, keeping it).
  */
-template<typename T, typename Allocator = std::allocator<T>>
+template<typename T, typename Allocator = std::allocator<T>, shrink_policy ShrinkPolicy = never_shrink>
 class swap_back_array : public std::vector<T, Allocator>
 {
 	using base = std::vector<T, Allocator>;
 
+	// Shares the index batch removal.
+	template<typename, typename>
+	friend class concurrent_swap_back_array;
+
+	// Shares the marked holes filling and the shrink policy.
+	template<typename, typename, shrink_policy>
+	friend class deferred_swap_back_array;
+
+	// Shares the marked holes filling.
+	template<typename U, typename A, shrink_policy P, std::predicate<U&> Pred>
+	friend std::size_t erase_swap_if_parallel(swap_back_array<U, A, P>& array, Pred pred, unsigned thread_count);
+
 public:
 
 	// Redeclare all base constructors.
@@ -126,7 +210,7 @@ public:
 	 * @brief Removes a range of elements starting from the specified index in O(1) time per element.
 	 *
 	 * This method swaps elements in the specified range with elements at the end of the container,
-	 * then removes the last elements.
+	 * then removes the last elements. Trivially relocatable elements are moved as a single block.
 	 *
 	 * @note The user must provide a valid range (start_index + count <= container.size()).
 	 * @note The type T must be move-assignable in order to use this method.
@@ -155,7 +239,8 @@ public:
 	 * @brief Removes the elements in range [first, last) in O(1) time per element.
 	 *
 	 * This method swaps the elements in the specified range with elements at the end of the container,
-	 * then removes them. The method returns a valid iterator, allowing safe continuation of iteration.
+	 * then removes them. Trivially relocatable elements are moved as a single block.
+	 * The method returns a valid iterator, allowing safe continuation of iteration.
 	 *
 	 * @note The user is responsible for providing a valid range ([first, last) must be within the container).
 	 * @note The type T must be move-assignable in order to use this method.
@@ -167,8 +252,157 @@ public:
 	 */
 	constexpr base::iterator erase_swap(base::iterator first, base::const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
 
+	/**
+	 * @brief Removes all elements satisfying a predicate in a single pass.
+	 *
+	 * This method walks the container once, filling each hole with a surviving element taken from the end,
+	 * then shrinks the container with a single erase. Each element is tested exactly once.
+	 *
+	 * @note The type T must be move-assignable in order to use this method.
+	 * @note The order of the remaining elements is not preserved.
+	 *
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	constexpr base::size_type erase_swap_if(Pred pred);
+
+	/**
+	 * @brief Removes the elements in range [first, last) satisfying a predicate in a single pass.
+	 *
+	 * Survivors of the range are compacted toward first, then the resulting block of removed elements
+	 * is filled from the end of the container and erased at once, as erase_swap(first, last) would.
+	 *
+	 * @note The user is responsible for providing a valid range ([first, last) must be within the container).
+	 * @note The type T must be move-assignable in order to use this method.
+	 * @note The order of the remaining elements is not preserved.
+	 *
+	 * @param first Iterator pointing to the first element to test.
+	 * @param last Iterator pointing one past the last element to test.
+	 * @param pred Predicate returning true for the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	template <std::predicate<T&> Pred>
+	constexpr base::size_type erase_swap_if(base::iterator first, base::const_iterator last, Pred pred);
+
+	/**
+	 * @brief Finds the first element equal to value.
+	 *
+	 * Integral and enumeration elements are searched with the vectorized kernels of simd_search, selected at runtime.
+	 * Other types are compared one by one with operator==.
+	 *
+	 * @param value The value to search for.
+	 * @return Iterator to the first element equal to value, or end() if there is none.
+	 */
+	[[nodiscard]] constexpr base::iterator find_swap(const T& value) requires std::equality_comparable<T>;
+	[[nodiscard]] constexpr base::const_iterator find_swap(const T& value) const requires std::equality_comparable<T>;
+
+	/**
+	 * @brief Removes the first element equal to value in O(1) time, after a vectorized search.
+	 *
+	 * @note The type T must be move-assignable in order to use this method.
+	 *
+	 * @param value The value to remove.
+	 * @return bool True if an element was removed, false if there was none equal to value.
+	 */
+	constexpr bool erase_swap_value(const T& value) requires std::equality_comparable<T>;
+
+	/**
+	 * @brief Removes all elements equal to value in a single pass.
+	 *
+	 * Same result as erase_swap_if with an equality predicate, but the runs of elements to keep are skipped by the
+	 * vectorized search of find_swap.
+	 *
+	 * @note The type T must be move-assignable in order to use this method.
+	 *
+	 * @param value The value to remove.
+	 * @return The number of removed elements.
+	 */
+	constexpr base::size_type erase_swap_all(const T& value) requires std::equality_comparable<T>;
+
+	/**
+	 * @brief Removes the elements at a set of indices, given in any order.
+	 *
+	 * Unlike calling erase_swap once per index, this method is not affected by earlier removals moving elements
+	 * that are also queued for removal. Duplicated indices are removed once. Each hole below the new size is filled
+	 * with a surviving element from the end, which is the minimum number of moves, then the container is shrunk
+	 * with a single erase. Small batches are sorted, large batches are marked in a bitmap of size() bits.
+	 *
+	 * @note The user must provide valid indices (each index < container.size()).
+	 * @note The type T must be move-assignable in order to use this method.
+	 *
+	 * @param indices The indices of the elements to remove.
+	 * @return The number of removed elements.
+	 */
+	constexpr base::size_type erase_swap_indices(std::span<const typename base::size_type> indices);
+
+	/**
+	 * @brief Removes an element at the specified index in O(1) time, and reports the element moved into its place.
+	 *
+	 * Same as erase_swap(element_index).
+	 *
+	 * @param element_index The index of the element to remove.
+	 * @return The relocation of the last element, or std::nullopt if the removed element was the last.
+	 */
+	constexpr std::optional<relocation> erase_swap_tracked(base::size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+	/**
+	 * @brief Removes a range of elements starting from the specified index, and reports the moved elements.
+	 *
+	 * Same as erase_swap(start_index, count). One record is written per moved element, at most count.
+	 * Not noexcept, as writing through out may throw (e.g. a std::back_insert_iterator).
+	 *
+	 * @param start_index The starting index of the range to remove.
+	 * @param count The number of elements to remove.
+	 * @param out Output iterator receiving the relocation records, e.g. a pointer into a caller-provided buffer.
+	 * @return out, past the last written record.
+	 */
+	template <std::output_iterator<relocation> Out>
+	constexpr Out erase_swap_tracked(base::size_type start_index, base::size_type count, Out out);
+
+	/**
+	 * @brief Removes the elements at a set of indices given in any order, and reports the moved elements.
+	 *
+	 * Same as erase_swap_indices(indices). One record is written per moved element, at most indices.size().
+	 *
+	 * @param indices The indices of the elements to remove.
+	 * @param out Output iterator receiving the relocation records, e.g. a pointer into a caller-provided buffer.
+	 * @return out, past the last written record.
+	 */
+	template <std::output_iterator<relocation> Out>
+	constexpr Out erase_swap_indices_tracked(std::span<const typename base::size_type> indices, Out out);
+
+private:
+
+	// Batches of at least size() / indices_bitmap_divisor indices are marked in a bitmap instead of sorted.
+	static constexpr typename base::size_type indices_bitmap_divisor = 64;
+
+	// Moves survivors of [0, size) into the holes left by indices below the new size, without destroying anything.
+	// on_move(from, to) is called for each moved element. Returns the number of removed elements.
+	template <typename OnMove>
+	static constexpr base::size_type fill_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move);
+	template <typename OnMove>
+	static constexpr base::size_type fill_sorted_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move);
+	template <typename OnMove>
+	static constexpr base::size_type fill_marked_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move);
+
+	// Moves count unmarked elements, scanned downward from next_moved_index, into the marked slots scanned upward
+	// from next_hole_index. There must be count of each in the scanned ranges.
+	template <typename OnMove>
+	static constexpr void fill_marked_holes(T* data, const std::uint64_t* marks, base::size_type next_hole_index, base::size_type next_moved_index, base::size_type count, OnMove on_move);
+
+	// Returns the index of the first element of [data, data + count) equal to value, or count.
+	static constexpr base::size_type find_index(const T* data, base::size_type count, const T& value);
+
+	// Reallocates to the capacity chosen by ShrinkPolicy, if it is smaller. Keeps the capacity if reallocation throws.
+	constexpr void apply_shrink_policy() noexcept;
+
+	// Moves the last count elements into [holes, holes + count), which must not overlap them.
+	// Trivially relocatable elements are moved as a block.
+	constexpr void move_to_holes(base::iterator holes, base::difference_type count) noexcept(std::is_nothrow_move_assignable_v<T>);
+
 };
 
 } // namespace stc
 
-#include "../src/swap_back_array.inl"
+#include "../../src/swap_back_array.inl"
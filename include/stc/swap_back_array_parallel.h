@@ -0,0 +1,50 @@
+#pragma once
+#include "swap_back_array.h"
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+/**
+ * @file
+ * @brief Multi-threaded removal for swap_back_array, kept apart so that the container itself needs no thread support.
+ *
+ * Programs using this header must link a thread library (e.g. Threads::Threads with CMake).
+ */
+
+namespace stc
+{
+
+/**
+ * @brief Removes all elements satisfying a predicate, splitting the work across several threads.
+ *
+ * The container is split into one chunk per thread. Each thread tests its chunk and marks the removed elements
+ * in a bitmap, then counts the holes below the new size and the survivors above it. The moves filling the holes
+ * are then shared evenly between the threads. Holes and survivors are paired as in erase_swap_if(pred), which
+ * gives the same result. Containers too small to benefit from threads are processed on the calling thread, as are
+ * all containers when a thread cannot be created.
+ *
+ * @note The predicate is called concurrently, once per element. If it or the move assignment of T throws,
+ * std::terminate is called, whichever thread it throws on.
+ * @note The type T must be move-assignable in order to use this function.
+ *
+ * @param array The container to remove the elements from.
+ * @param pred Predicate returning true for the elements to remove.
+ * @param thread_count The maximum number of threads to use, including the calling thread.
+ * @return The number of removed elements.
+ */
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy, std::predicate<T&> Pred>
+std::size_t erase_swap_if_parallel(swap_back_array<T, Allocator, ShrinkPolicy>& array, Pred pred, unsigned thread_count);
+
+/**
+ * @brief Same as erase_swap_if_parallel(array, pred, thread_count), using every hardware thread.
+ */
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy, std::predicate<T&> Pred>
+std::size_t erase_swap_if_parallel(swap_back_array<T, Allocator, ShrinkPolicy>& array, Pred pred)
+{
+	return erase_swap_if_parallel(array, std::move(pred), std::thread::hardware_concurrency());
+}
+
+} // namespace stc
+
+#include "../../src/swap_back_array_parallel.inl"
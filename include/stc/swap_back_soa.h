@@ -0,0 +1,142 @@
+#pragma once
+#include "swap_back_array.h"
+#include "swap_partition.h"
+#include <span>
+#include <tuple>
+
+namespace stc
+{
+
+/**
+ * @brief A structure-of-arrays container providing fast O(1) removal at any index.
+ *
+ * Each column of type Ts is stored in its own contiguous swap_back_array, all columns sharing the same
+ * size. Removal swaps the row with the last one in every column, keeping the columns in sync.
+ * Loops touching a few columns only load those, and can be auto-vectorized through column().
+ *
+ * @note Like swap_back_array, this container sacrifices the order of rows.
+ *
+ * @tparam Ts Types of the columns.
+ */
+template<typename... Ts>
+class swap_back_soa
+{
+	static_assert(sizeof...(Ts) > 0, "swap_back_soa needs at least one column.");
+
+public:
+
+	using size_type = std::size_t;
+
+	template <size_type I>
+	using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+	constexpr swap_back_soa() = default;
+
+	/**
+	 * @brief Appends a row, constructing each column element from one argument.
+	 *
+	 * @note If a column throws, the row is not added.
+	 *
+	 * @tparam Args Types of the arguments, one per column.
+	 * @param args Arguments forwarded to the column constructors.
+	 */
+	template <typename... Args>
+		requires (sizeof...(Args) == sizeof...(Ts))
+	constexpr void emplace_back(Args&&... args);
+
+	/**
+	 * @brief Removes the row at the specified index in O(1) time.
+	 *
+	 * @note The user must provide a valid index.
+	 * @note If the user is iterating over the container, the same index should be reused for the next iteration after each removal.
+	 *
+	 * @param row_index The index of the row to remove.
+	 */
+	constexpr void erase_swap(size_type row_index) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...));
+
+	/**
+	 * @brief Removes a range of rows starting from the specified index in O(1) time per row.
+	 *
+	 * @note The user must provide a valid range (start_index + count <= size()).
+	 *
+	 * @param start_index The starting index of the range to remove.
+	 * @param count The number of rows to remove.
+	 */
+	constexpr void erase_swap(size_type start_index, size_type count) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...));
+
+	/**
+	 * @brief Removes all rows satisfying a predicate in a single pass.
+	 *
+	 * The predicate receives one reference per column. Holes are filled with surviving rows taken
+	 * from the end, then every column is shrunk with a single erase.
+	 *
+	 * @param pred Predicate returning true for the rows to remove.
+	 * @return The number of removed rows.
+	 */
+	template <std::predicate<Ts&...> Pred>
+	constexpr size_type erase_swap_if(Pred pred);
+
+	/**
+	 * @brief Removes the rows in range [start_index, start_index + count) satisfying a predicate in a single pass.
+	 *
+	 * @note The user must provide a valid range (start_index + count <= size()).
+	 *
+	 * @param start_index The starting index of the range to test.
+	 * @param count The number of rows to test.
+	 * @param pred Predicate returning true for the rows to remove.
+	 * @return The number of removed rows.
+	 */
+	template <std::predicate<Ts&...> Pred>
+	constexpr size_type erase_swap_if(size_type start_index, size_type count, Pred pred);
+
+	/**
+	 * @brief Retrieves a contiguous view over one column.
+	 *
+	 * @note The view is invalidated by any operation changing the size or capacity.
+	 *
+	 * @tparam I Index of the column.
+	 * @return std::span over the column elements.
+	 */
+	template <size_type I>
+	[[nodiscard]] constexpr std::span<column_type<I>> column() noexcept { return std::get<I>(columns_); }
+
+	template <size_type I>
+	[[nodiscard]] constexpr std::span<const column_type<I>> column() const noexcept { return std::get<I>(columns_); }
+
+	/**
+	 * @brief Retrieves references to every element of a row.
+	 *
+	 * @note The user must provide a valid index.
+	 *
+	 * @param row_index The index of the row.
+	 * @return std::tuple of references, one per column.
+	 */
+	[[nodiscard]] constexpr std::tuple<Ts&...> row(size_type row_index) noexcept;
+	[[nodiscard]] constexpr std::tuple<const Ts&...> row(size_type row_index) const noexcept;
+
+	/**
+	 * @brief Reserves storage for at least new_capacity rows in every column.
+	 *
+	 * @param new_capacity The number of rows to reserve storage for.
+	 */
+	constexpr void reserve(size_type new_capacity);
+
+	/**
+	 * @brief Removes all rows.
+	 */
+	constexpr void clear() noexcept;
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return std::get<0>(columns_).size(); }
+	[[nodiscard]] constexpr bool empty() const noexcept { return std::get<0>(columns_).empty(); }
+
+private:
+
+	// Moves row src into row dst in every column.
+	constexpr void move_row(size_type dst, size_type src) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...));
+
+	std::tuple<swap_back_array<Ts>...> columns_;
+};
+
+} // namespace stc
+
+#include "../../src/swap_back_soa.inl"
@@ -0,0 +1,55 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+
+/**
+ * @file
+ * @brief Single pass partition shared by the erase_swap_if of the swap back containers.
+ */
+
+namespace stc
+{
+
+/**
+ * @brief Moves the survivors of [first, last) to the front of the range, filling each removed slot with the last survivor.
+ *
+ * Each element is tested once, and each survivor is moved at most once. The elements left at
+ * [returned index, last) are the removed ones, or moved-from survivors; the caller erases them.
+ *
+ * @tparam Index Integer type of the element indices.
+ * @param first Index of the first element of the range.
+ * @param last Index one past the last element of the range.
+ * @param remove Callable invoked as remove(index), returning true if the element must be removed.
+ * @param relocate Callable invoked as relocate(to, from), moving the element at index from into the slot at index to.
+ * @return Index one past the last survivor.
+ */
+template <std::integral Index, typename Remove, typename Relocate>
+constexpr Index swap_partition(Index first, Index last, Remove remove, Relocate relocate)
+{
+	auto next_tested = first;
+	auto next_moved = last;
+	while (true)
+	{
+		// find the next element to remove
+		while (next_tested != next_moved && !remove(next_tested))
+			++next_tested;
+
+		if (next_tested == next_moved)
+			break;
+
+		// find the last surviving element to fill the hole with
+		do
+			--next_moved;
+		while (next_moved != next_tested && remove(next_moved));
+
+		if (next_moved == next_tested)
+			break;
+
+		relocate(next_tested, next_moved);
+		++next_tested;
+	}
+
+	return next_tested;
+}
+
+} // namespace stc
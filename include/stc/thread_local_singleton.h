@@ -0,0 +1,152 @@
+#pragma once
+#include "interference_size.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace stc
+{
+
+/**
+ * @brief Singleton with one instance per thread, created upon the first access of each thread.
+ *
+ * Each instance lives on its own cache lines, so threads updating their instance never share a line: no atomic
+ * operation nor false sharing on the hot path. Instances are registered in a lock-free list, so that
+ * for_each_instance and combine can aggregate them. The instances of exited threads stay registered.
+ *
+ * @note Instances are freed at static destruction only: the registry grows with the number of threads that
+ * accessed the singleton during the program.
+ * @note Reading the instances of other threads while they update them is a data race, unless the fields are atomic.
+ * Owners can update atomic fields with relaxed loads and stores, there is a single writer per instance.
+ * @note It is recommended to use this class with the CRTP idiom to fully leverage the provided syntax.
+ *
+ * @tparam T The type of the singleton instances.
+ */
+template <typename T>
+class thread_local_singleton
+{
+public:
+
+	/**
+	 * @brief Retrieves the instance of the calling thread.
+	 *
+	 * On the first call of a thread, constructs and registers its instance.
+	 *
+	 * @return T& Reference to the instance of the calling thread.
+	 */
+	[[nodiscard]] static T& instance()
+	{
+		// constant initialized, the thread local access needs no guard
+		thread_local slot* local = nullptr;
+		if (!local) [[unlikely]]
+			local = register_slot();
+		return local->storage.instance_;
+	}
+
+	/**
+	 * @brief Calls f on every registered instance, including the ones of exited threads.
+	 *
+	 * @note Instances registered during the call may be skipped.
+	 *
+	 * @param f Callable invoked with a T& for each instance.
+	 */
+	template <typename F>
+	static void for_each_instance(F f)
+	{
+		for (auto* s = registry_.head.load(std::memory_order_acquire); s; s = s->next)
+			f(s->storage.instance_);
+	}
+
+	/**
+	 * @brief Folds every registered instance into a single value, as std::accumulate would.
+	 *
+	 * @param init The initial value of the result.
+	 * @param op Callable invoked as op(R, const T&) for each instance, returning the next value of the result.
+	 * @return R The folded value.
+	 */
+	template <typename R, typename Op>
+	[[nodiscard]] static R combine(R init, Op op)
+	{
+		for_each_instance([&](const T& instance) { init = op(std::move(init), instance); });
+		return init;
+	}
+
+	/**
+	 * @brief Returns the number of registered instances.
+	 */
+	[[nodiscard]] static std::size_t instance_count() noexcept
+	{
+		return registry_.count.load(std::memory_order_relaxed);
+	}
+
+protected:
+
+	// Enables construction of T.
+	thread_local_singleton() = default;
+
+private:
+
+	// Disable copy and move semantics.
+	thread_local_singleton(const thread_local_singleton&) = delete;
+	thread_local_singleton(thread_local_singleton&&) = delete;
+	thread_local_singleton& operator=(const thread_local_singleton&) = delete;
+	thread_local_singleton& operator=(thread_local_singleton&&) = delete;
+
+	// An instance and its link in the registry, on cache lines of their own.
+	struct alignas(std::max(destructive_interference, alignof(T))) slot
+	{
+		union storage_type
+		{
+			storage_type() { /* Constructed by register_slot. */ };
+			~storage_type() {}
+
+			T instance_;
+		} storage;
+
+		slot* next = nullptr;
+	};
+
+	struct registry
+	{
+		// No thread uses its instance at static destruction.
+		~registry()
+		{
+			for (auto* s = head.load(std::memory_order_relaxed); s;)
+			{
+				s->storage.instance_.~T();
+				delete std::exchange(s, s->next);
+			}
+		}
+
+		// Slots are only pushed, never removed, so the list can be walked without lock.
+		std::atomic<slot*> head = nullptr;
+		std::atomic<std::size_t> count = 0;
+	};
+
+	static slot* register_slot()
+	{
+		auto* s = new slot;
+		try
+		{
+			new (&s->storage.instance_) T();
+		}
+		catch (...)
+		{
+			delete s;
+			throw;
+		}
+
+		s->next = registry_.head.load(std::memory_order_relaxed);
+		while (!registry_.head.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		registry_.count.fetch_add(1, std::memory_order_relaxed);
+		return s;
+	}
+
+	static inline registry registry_;
+};
+
+} // namespace stc
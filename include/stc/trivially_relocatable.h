@@ -0,0 +1,114 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @file
+ * @brief Opt-in trait for types that can be moved in memory with a plain byte copy.
+ *
+ * Relocating an object means move-constructing it at a new address and destroying the original.
+ * For trivially relocatable types, this is equivalent to copying its bytes and forgetting the original,
+ * which lets containers move blocks of elements with memcpy/memmove.
+ */
+
+namespace stc
+{
+
+/**
+ * @brief Trait telling whether T can be relocated with a byte copy.
+ *
+ * True for trivially copyable types. Other types can opt in by specializing it, which is valid for most types
+ * that do not store pointers into themselves (e.g. std::unique_ptr-like handles).
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief Relocates the elements of [first, last) into the uninitialized storage starting at dest.
+ *
+ * After the call, the source elements are no longer alive and must not be destroyed.
+ *
+ * @note The ranges must not overlap.
+ *
+ * @tparam T Type of the elements, it must be trivially relocatable or nothrow move-constructible.
+ * @param first Pointer to the first element to relocate.
+ * @param last Pointer one past the last element to relocate.
+ * @param dest Pointer to the destination storage.
+ * @return Pointer one past the last relocated element in the destination.
+ */
+template <typename T>
+	requires is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>
+T* uninitialized_relocate(T* first, T* last, T* dest) noexcept
+{
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		auto count = static_cast<std::size_t>(last - first);
+		if (count != 0)
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+		return dest + count;
+	}
+	else
+	{
+		for (; first != last; ++first, ++dest)
+		{
+			std::construct_at(dest, std::move(*first));
+			std::destroy_at(first);
+		}
+		return dest;
+	}
+}
+
+/**
+ * @brief Exchanges the bytes of two non-overlapping ranges of trivially relocatable elements.
+ *
+ * Both ranges keep holding count alive elements, which is equivalent to relocating each of them to the other range.
+ *
+ * @tparam T Type of the elements, it must be trivially relocatable.
+ * @param a Pointer to the first range.
+ * @param b Pointer to the second range.
+ * @param count The number of elements in each range.
+ */
+template <typename T>
+	requires is_trivially_relocatable_v<T>
+void swap_relocate(T* a, T* b, std::size_t count) noexcept
+{
+	auto* a_bytes = reinterpret_cast<std::byte*>(a);
+	auto* b_bytes = reinterpret_cast<std::byte*>(b);
+	auto bytes = count * sizeof(T);
+
+	constexpr std::size_t chunk_size = 256;
+	std::byte buffer[chunk_size];
+	for (std::size_t offset = 0; offset < bytes; offset += chunk_size)
+	{
+		auto chunk = bytes - offset < chunk_size ? bytes - offset : chunk_size;
+		std::memcpy(buffer, a_bytes + offset, chunk);
+		std::memcpy(a_bytes + offset, b_bytes + offset, chunk);
+		std::memcpy(b_bytes + offset, buffer, chunk);
+	}
+}
+
+/**
+ * @brief Allocators able to resize a buffer of trivially relocatable elements, possibly without copying it.
+ *
+ * alloc.reallocate(ptr, old_count, new_count) returns a buffer of new_count elements holding the first
+ * min(old_count, new_count) elements of ptr, which is released. If it throws, ptr is left untouched.
+ * Containers owning their storage grow buffers of trivially relocatable elements through it,
+ * e.g. huge_page_allocator remaps large buffers with mremap.
+ *
+ * @tparam Allocator The allocator type to check.
+ */
+template <typename Allocator>
+concept reallocating_allocator = requires(Allocator& alloc, typename std::allocator_traits<Allocator>::pointer ptr, std::size_t count)
+{
+	{ alloc.reallocate(ptr, count, count) } -> std::same_as<typename std::allocator_traits<Allocator>::pointer>;
+};
+
+} // namespace stc
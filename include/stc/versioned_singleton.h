@@ -0,0 +1,291 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace stc
+{
+
+/**
+ * @brief Singleton whose instance can be replaced while other threads are reading it.
+ *
+ * Each call to construct_instance publishes a new version of the instance with an atomic pointer swap. Readers
+ * access the instance through a read_guard, and the version they see stays alive until their guard is destroyed:
+ * replaced versions are retired, and only freed once every reader that could still see them has left its guard
+ * (epoch-based reclamation). Readers never block nor wait for writers, writers are serialized by a mutex.
+ *
+ * Entering a guard is a thread local access, a sequentially consistent store and a load of the current version.
+ *
+ * @note Versions are allocated on the heap, and are read-only: publish a new version to change the instance.
+ * @note Each thread that reads keeps a small record registered for the lifetime of the program, reused by later threads.
+ * @note It is recommended to use this class with the CRTP idiom to fully leverage the provided syntax.
+ *
+ * @tparam T The type of the singleton instance.
+ */
+template <typename T>
+class versioned_singleton
+{
+	struct reader_record;
+
+public:
+
+	/**
+	 * @brief Keeps the version of the instance seen by the reader alive until destroyed.
+	 *
+	 * @note Guards are bound to the thread that created them. They can be nested on the same thread.
+	 */
+	class read_guard
+	{
+	public:
+
+		read_guard(const read_guard&) = delete;
+		read_guard& operator=(const read_guard&) = delete;
+
+		~read_guard() { versioned_singleton::leave(*record_); }
+
+		/**
+		 * @brief Retrieves the version seen by this guard, or nullptr if there was no instance.
+		 */
+		[[nodiscard]] const T* get() const noexcept { return instance_; }
+
+		[[nodiscard]] const T& operator*() const noexcept { assert(instance_ && "Reading uninitialized singleton instance."); return *instance_; }
+		[[nodiscard]] const T* operator->() const noexcept { assert(instance_ && "Reading uninitialized singleton instance."); return instance_; }
+		[[nodiscard]] explicit operator bool() const noexcept { return instance_ != nullptr; }
+
+	private:
+
+		friend versioned_singleton;
+
+		read_guard(reader_record& record, const T* instance) noexcept : record_(&record), instance_(instance) {}
+
+		reader_record* record_;
+		const T* instance_;
+	};
+
+	/**
+	 * @brief Constructs a new version of the instance and publishes it.
+	 *
+	 * The new version is constructed before taking the writer lock. The previous version is retired, readers
+	 * already holding it keep using it, new readers see the new version.
+	 *
+	 * @note If T's constructor throws, the current version is left untouched.
+	 *
+	 * @tparam Args Parameter pack for T's constructor.
+	 * @param args Arguments forwarded to T's constructor.
+	 */
+	template <typename... Args>
+	static void construct_instance(Args&&... args)
+	{
+		publish(new T(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Checks whether a version of the instance is published.
+	 *
+	 * @return bool True if an instance is published, false otherwise.
+	 */
+	[[nodiscard]] static bool instance_constructed() noexcept
+	{
+		return registry_.current.load(std::memory_order_acquire) != nullptr;
+	}
+
+	/**
+	 * @brief Enters a read-side critical section, and retrieves the current version of the instance.
+	 *
+	 * @note The first call on a thread registers its record, which may allocate.
+	 *
+	 * @return read_guard Guard to the current version, empty if there is no instance.
+	 */
+	[[nodiscard]] static read_guard read()
+	{
+		auto& record = local_record();
+		if (record.depth++ == 0)
+		{
+			// published before loading the instance: a writer scanning the records after its swap sees this reader,
+			// or this reader sees the new version
+			record.epoch.store(registry_.epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+		}
+		return read_guard(record, registry_.current.load(std::memory_order_seq_cst));
+	}
+
+	/**
+	 * @brief Unpublishes the instance. The last version is retired, as a replaced one would be.
+	 */
+	static void destruct_instance()
+	{
+		publish(nullptr);
+	}
+
+	/**
+	 * @brief Waits until every version retired before the call is freed.
+	 *
+	 * @note Must not be called while the calling thread holds a read_guard.
+	 */
+	static void synchronize()
+	{
+		auto target = registry_.epoch.load(std::memory_order_acquire);
+		while (true)
+		{
+			{
+				std::lock_guard lock(registry_.writer_mutex);
+				reclaim();
+				if (std::ranges::none_of(registry_.retired, [=](const retired_instance& r) { return r.epoch < target; }))
+					return;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * @brief Returns the number of retired versions not freed yet.
+	 */
+	[[nodiscard]] static std::size_t retired_count()
+	{
+		std::lock_guard lock(registry_.writer_mutex);
+		return registry_.retired.size();
+	}
+
+protected:
+
+	// Enables construction of T.
+	versioned_singleton() = default;
+
+private:
+
+	// Disable copy and move semantics.
+	versioned_singleton(const versioned_singleton&) = delete;
+	versioned_singleton(versioned_singleton&&) = delete;
+	versioned_singleton& operator=(const versioned_singleton&) = delete;
+	versioned_singleton& operator=(versioned_singleton&&) = delete;
+
+	// Read-side state of a thread, on its own cache line.
+	struct alignas(64) reader_record
+	{
+		// Epoch seen when entering the outermost guard, 0 while the thread holds no guard.
+		std::atomic<std::uint64_t> epoch = 0;
+		std::atomic<bool> in_use = true;
+		reader_record* next = nullptr;
+		// Number of nested guards, only accessed by the owning thread.
+		std::size_t depth = 0;
+	};
+
+	struct retired_instance
+	{
+		T* instance;
+		// Epoch when the version was replaced: readers that entered later cannot see it.
+		std::uint64_t epoch;
+	};
+
+	struct registry
+	{
+		// No reader remains at static destruction, every version and record is freed.
+		~registry()
+		{
+			delete current.load(std::memory_order_relaxed);
+			for (auto& r : retired)
+				delete r.instance;
+			for (auto* r = readers.load(std::memory_order_relaxed); r;)
+				delete std::exchange(r, r->next);
+		}
+
+		std::atomic<T*> current = nullptr;
+		std::atomic<std::uint64_t> epoch = 1;
+		// Records are only pushed, never removed, so the list can be walked without lock.
+		std::atomic<reader_record*> readers = nullptr;
+		std::mutex writer_mutex;
+		std::vector<retired_instance> retired;
+	};
+
+	// Swaps the current version with fresh, and retires the previous one.
+	static void publish(T* fresh)
+	{
+		std::unique_lock lock(registry_.writer_mutex, std::defer_lock);
+		try
+		{
+			lock.lock();
+			registry_.retired.reserve(registry_.retired.size() + 1);
+		}
+		catch (...)
+		{
+			delete fresh;
+			throw;
+		}
+
+		if (T* old = registry_.current.exchange(fresh, std::memory_order_seq_cst))
+			registry_.retired.push_back({ old, registry_.epoch.fetch_add(1, std::memory_order_seq_cst) });
+		reclaim();
+	}
+
+	// Frees the retired versions no reader can see anymore. Called with the writer lock held.
+	static void reclaim()
+	{
+		if (registry_.retired.empty())
+			return;
+
+		auto oldest = std::numeric_limits<std::uint64_t>::max();
+		// sequentially consistent, as is the push of a new record: a reader registering during the swap is either
+		// in the list, or loads the instance after the swap
+		for (auto* r = registry_.readers.load(std::memory_order_seq_cst); r; r = r->next)
+		{
+			auto epoch = r->epoch.load(std::memory_order_seq_cst);
+			if (epoch != 0)
+				oldest = std::min(oldest, epoch);
+		}
+
+		// a reader that entered at epoch e may see the versions retired at epoch e or later
+		std::erase_if(registry_.retired, [=](const retired_instance& r)
+		{
+			if (r.epoch >= oldest)
+				return false;
+			delete r.instance;
+			return true;
+		});
+	}
+
+	static void leave(reader_record& record) noexcept
+	{
+		if (--record.depth == 0)
+			record.epoch.store(0, std::memory_order_release);
+	}
+
+	// Reuses the record of an exited thread, or registers a new one.
+	static reader_record* acquire_record()
+	{
+		for (auto* r = registry_.readers.load(std::memory_order_acquire); r; r = r->next)
+		{
+			bool expected = false;
+			if (!r->in_use.load(std::memory_order_relaxed) && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return r;
+		}
+
+		auto* record = new reader_record;
+		record->next = registry_.readers.load(std::memory_order_relaxed);
+		// pushed before the first load of the instance: a writer scanning the records after its swap sees this
+		// record, or this reader sees the new version
+		while (!registry_.readers.compare_exchange_weak(record->next, record, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+		}
+		return record;
+	}
+
+	static reader_record& local_record()
+	{
+		struct owner
+		{
+			~owner() { record->in_use.store(false, std::memory_order_release); }
+			reader_record* record = acquire_record();
+		};
+		thread_local owner local;
+		return *local.record;
+	}
+
+	static inline registry registry_;
+};
+
+} // namespace stc
@@ -0,0 +1,177 @@
+#pragma once
+#include "../include/stc/concurrent_swap_back_array.h"
+#include <algorithm>
+
+namespace stc
+{
+
+template<typename T, typename Allocator>
+inline concurrent_swap_back_array<T, Allocator>::concurrent_swap_back_array(size_type capacity, const Allocator& alloc)
+	: alloc_(alloc)
+{
+	reserve(capacity);
+}
+
+template<typename T, typename Allocator>
+inline concurrent_swap_back_array<T, Allocator>::~concurrent_swap_back_array()
+{
+	destroy_back_to(0);
+	if (data_)
+		alloc_traits::deallocate(alloc_, data_, capacity_);
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+	requires std::is_nothrow_constructible_v<T, Args...>
+inline T* concurrent_swap_back_array<T, Allocator>::try_emplace_back(Args&&... args) noexcept
+{
+	// claim a slot, the cursor never goes past the capacity
+	auto index = cursor_.load(std::memory_order_relaxed);
+	do
+	{
+		if (index == capacity_)
+			return nullptr;
+	} while (!cursor_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+	T* element = data_ + index;
+	alloc_traits::construct(alloc_, element, std::forward<Args>(args)...);
+	return element;
+}
+
+template<typename T, typename Allocator>
+inline void concurrent_swap_back_array<T, Allocator>::erase_swap(size_type element_index)
+{
+	local_queue().indices.push_back(element_index);
+}
+
+template<typename T, typename Allocator>
+inline concurrent_swap_back_array<T, Allocator>::size_type concurrent_swap_back_array<T, Allocator>::flush()
+{
+	return flush_impl([](size_type, size_type) {});
+}
+
+template<typename T, typename Allocator>
+template<std::output_iterator<relocation> Out>
+inline Out concurrent_swap_back_array<T, Allocator>::flush_tracked(Out out)
+{
+	flush_impl([&out](size_type from, size_type to)
+	{
+		*out++ = relocation{from, to};
+	});
+	return out;
+}
+
+template<typename T, typename Allocator>
+inline concurrent_swap_back_array<T, Allocator>::size_type concurrent_swap_back_array<T, Allocator>::pending_erase_count() const noexcept
+{
+	size_type count = 0;
+	for (auto& queue : queues_)
+		count += queue->indices.size();
+	return count;
+}
+
+template<typename T, typename Allocator>
+inline void concurrent_swap_back_array<T, Allocator>::reserve(size_type new_capacity)
+{
+	if (new_capacity <= capacity_)
+		return;
+
+	if constexpr (reallocating_allocator<Allocator> && is_trivially_relocatable_v<T>)
+	{
+		// the allocator may resize the buffer without copying it
+		if (data_)
+		{
+			data_ = alloc_.reallocate(data_, capacity_, new_capacity);
+			capacity_ = new_capacity;
+			return;
+		}
+	}
+
+	auto size = this->size();
+	T* new_data = alloc_traits::allocate(alloc_, new_capacity);
+	try
+	{
+		std::uninitialized_move(data_, data_ + size, new_data);
+	}
+	catch (...)
+	{
+		alloc_traits::deallocate(alloc_, new_data, new_capacity);
+		throw;
+	}
+
+	destroy_back_to(0);
+	if (data_)
+		alloc_traits::deallocate(alloc_, data_, capacity_);
+
+	data_ = new_data;
+	capacity_ = new_capacity;
+	cursor_.store(size, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+inline void concurrent_swap_back_array<T, Allocator>::clear() noexcept
+{
+	destroy_back_to(0);
+	for (auto& queue : queues_)
+		queue->indices.clear();
+}
+
+template<typename T, typename Allocator>
+inline concurrent_swap_back_array<T, Allocator>::erase_queue& concurrent_swap_back_array<T, Allocator>::local_queue()
+{
+	struct cache
+	{
+		std::uint64_t container_id = ~std::uint64_t(0);
+		erase_queue* queue = nullptr;
+	};
+	thread_local cache last_used;
+
+	if (last_used.container_id == id_)
+		return *last_used.queue;
+
+	std::scoped_lock lock(queues_mutex_);
+
+	auto thread_id = std::this_thread::get_id();
+	auto it = std::find_if(queues_.begin(), queues_.end(), [&](const auto& queue) { return queue->owner == thread_id; });
+	if (it == queues_.end())
+	{
+		queues_.push_back(std::make_unique<erase_queue>(thread_id));
+		it = queues_.end() - 1;
+	}
+
+	last_used = {id_, it->get()};
+	return **it;
+}
+
+template<typename T, typename Allocator>
+template<typename OnMove>
+inline concurrent_swap_back_array<T, Allocator>::size_type concurrent_swap_back_array<T, Allocator>::flush_impl(OnMove on_move)
+{
+	// the queues are merged to find duplicates and skip queued elements when filling holes
+	flushed_indices_.clear();
+	for (auto& queue : queues_)
+	{
+		flushed_indices_.insert(flushed_indices_.end(), queue->indices.begin(), queue->indices.end());
+		queue->indices.clear();
+	}
+
+	// same strategies and filling order as swap_back_array::erase_swap_indices
+	auto removed = swap_back_array<T, Allocator>::fill_index_holes(data_, size(), flushed_indices_, std::move(on_move));
+	auto new_size = size() - removed;
+
+	destroy_back_to(new_size);
+	return removed;
+}
+
+template<typename T, typename Allocator>
+inline void concurrent_swap_back_array<T, Allocator>::destroy_back_to(size_type new_size) noexcept
+{
+	auto size = this->size();
+	assert(new_size <= size);
+
+	for (; size > new_size; --size)
+		alloc_traits::destroy(alloc_, data_ + size - 1);
+	cursor_.store(new_size, std::memory_order_relaxed);
+}
+
+} // namespace stc
@@ -0,0 +1,155 @@
+#pragma once
+#include "../include/stc/deferred_swap_back_array.h"
+#include <algorithm>
+#include <bit>
+
+namespace stc
+{
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr deferred_swap_back_array<T, Allocator, ShrinkPolicy>::deferred_swap_back_array(const Allocator& alloc)
+	: values_(alloc)
+	, erased_(word_allocator(alloc))
+{
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename... Args>
+inline constexpr T& deferred_swap_back_array<T, Allocator, ShrinkPolicy>::emplace_back(Args&&... args)
+{
+	// the bitset grows first, the new word is dropped if the construction throws
+	bool new_word = values_.size() % word_bits == 0;
+	if (new_word)
+		erased_.push_back(0);
+
+	try
+	{
+		return values_.emplace_back(std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		if (new_word)
+			erased_.pop_back();
+		throw;
+	}
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr bool deferred_swap_back_array<T, Allocator, ShrinkPolicy>::erase_deferred(size_type index) noexcept
+{
+	assert(index < values_.size());
+
+	auto& word = erased_[index / word_bits];
+	auto bit = std::uint64_t(1) << (index % word_bits);
+	if (word & bit)
+		return false;
+
+	word |= bit;
+	++erased_count_;
+	return true;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr deferred_swap_back_array<T, Allocator, ShrinkPolicy>::size_type deferred_swap_back_array<T, Allocator, ShrinkPolicy>::compact() noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	return compact_slots([](size_type, size_type) {});
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<std::output_iterator<relocation> Out>
+inline constexpr Out deferred_swap_back_array<T, Allocator, ShrinkPolicy>::compact_tracked(Out out)
+{
+	compact_slots([&out](size_type from, size_type to)
+	{
+		*out++ = relocation{from, to};
+	});
+	return out;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr bool deferred_swap_back_array<T, Allocator, ShrinkPolicy>::is_erased(size_type index) const noexcept
+{
+	assert(index < values_.size());
+	return (erased_[index / word_bits] >> (index % word_bits)) & 1;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr T& deferred_swap_back_array<T, Allocator, ShrinkPolicy>::operator[](size_type index) noexcept
+{
+	assert(!is_erased(index));
+	return values_[index];
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr const T& deferred_swap_back_array<T, Allocator, ShrinkPolicy>::operator[](size_type index) const noexcept
+{
+	assert(!is_erased(index));
+	return values_[index];
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void deferred_swap_back_array<T, Allocator, ShrinkPolicy>::clear() noexcept
+{
+	values_.clear();
+	erased_.clear();
+	erased_count_ = 0;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void deferred_swap_back_array<T, Allocator, ShrinkPolicy>::reserve(size_type new_capacity)
+{
+	erased_.reserve((new_capacity + word_bits - 1) / word_bits);
+	values_.reserve(new_capacity);
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr deferred_swap_back_array<T, Allocator, ShrinkPolicy>::size_type deferred_swap_back_array<T, Allocator, ShrinkPolicy>::next_live(size_type index) const noexcept
+{
+	auto count = values_.size();
+	if (erased_count_ == 0 || index >= count)
+		return index; // nothing to skip
+
+	if ((~erased_[index / word_bits] >> (index % word_bits)) & 1)
+		return index; // live, the common case
+
+	// skips whole words of erased slots
+	while (index < count)
+	{
+		auto bits = ~erased_[index / word_bits] & (~std::uint64_t(0) << (index % word_bits));
+		if (bits != 0)
+			return std::min(index - index % word_bits + std::countr_zero(bits), count);
+		index = index - index % word_bits + word_bits;
+	}
+	return count;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename OnMove>
+inline constexpr deferred_swap_back_array<T, Allocator, ShrinkPolicy>::size_type deferred_swap_back_array<T, Allocator, ShrinkPolicy>::compact_slots(OnMove on_move) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	auto removed = erased_count_;
+	if (removed == 0)
+		return 0; // no-op
+
+	auto size = values_.size();
+	auto new_size = size - removed;
+
+	// count the holes, i.e. the erased slots below new_size
+	size_type holes = 0;
+	for (size_type w = 0; w < new_size / word_bits; ++w)
+		holes += std::popcount(erased_[w]);
+	if (new_size % word_bits != 0)
+		holes += std::popcount(erased_[new_size / word_bits] & ~(~std::uint64_t(0) << (new_size % word_bits)));
+
+	swap_back_array<T, Allocator, ShrinkPolicy>::fill_marked_holes(values_.data(), erased_.data(), 0, size - 1, holes, std::move(on_move));
+	values_.erase(values_.end() - removed, values_.end());
+
+	erased_.resize((new_size + word_bits - 1) / word_bits);
+	std::fill(erased_.begin(), erased_.end(), 0);
+	erased_count_ = 0;
+
+	values_.apply_shrink_policy();
+	return removed;
+}
+
+} // namespace stc
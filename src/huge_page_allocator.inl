@@ -0,0 +1,170 @@
+#pragma once
+#include "../include/stc/huge_page_allocator.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace stc
+{
+
+inline void* huge_page_resource::allocate(size_type bytes, size_type alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= huge_page_size);
+
+#if defined(__linux__)
+	if (bytes >= min_huge_allocation)
+		return map_huge_pages(bytes);
+#endif
+
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		return ::operator new(bytes, std::align_val_t(alignment));
+	return ::operator new(bytes);
+}
+
+inline void huge_page_resource::deallocate(void* ptr, size_type bytes, size_type alignment) noexcept
+{
+#if defined(__linux__)
+	if (bytes >= min_huge_allocation)
+	{
+		::munmap(ptr, round_to_huge_pages(bytes));
+		return;
+	}
+#endif
+
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		::operator delete(ptr, bytes, std::align_val_t(alignment));
+	else
+		::operator delete(ptr, bytes);
+}
+
+inline void* huge_page_resource::reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+{
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+	if (old_bytes >= min_huge_allocation && new_bytes >= min_huge_allocation)
+	{
+		auto old_size = round_to_huge_pages(old_bytes);
+		auto new_size = round_to_huge_pages(new_bytes);
+		auto* bytes = static_cast<std::byte*>(ptr);
+		if (new_size <= old_size)
+		{
+			if (new_size < old_size)
+				::munmap(bytes + new_size, old_size - new_size);
+			return ptr;
+		}
+
+		// grow in place when the following addresses are free
+		if (::mremap(ptr, old_size, new_size, 0) != MAP_FAILED)
+		{
+			::madvise(bytes + old_size, new_size - old_size, MADV_HUGEPAGE);
+			return ptr;
+		}
+
+		// otherwise move the pages over a reserved aligned range, without copying them
+		if (void* target = map_aligned(new_size))
+		{
+			void* moved = ::mremap(ptr, old_size, new_size, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+			if (moved != MAP_FAILED)
+			{
+				::madvise(moved, new_size, MADV_HUGEPAGE);
+				return moved;
+			}
+			::munmap(target, new_size);
+		}
+		// explicit huge pages may refuse to be remapped, copy them
+	}
+#endif
+
+	void* new_ptr = allocate(new_bytes, alignment);
+	std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+	deallocate(ptr, old_bytes, alignment);
+	return new_ptr;
+}
+
+inline void* huge_page_resource::map_huge_pages([[maybe_unused]] size_type bytes)
+{
+#if defined(__linux__)
+	auto size = round_to_huge_pages(bytes);
+
+#if defined(MAP_HUGETLB)
+	if (explicit_huge_pages_available())
+	{
+#if defined(MAP_HUGE_SHIFT)
+		// request 2 MiB pages even when the default huge page size is different
+		constexpr int huge_flags = MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+#else
+		constexpr int huge_flags = MAP_HUGETLB;
+#endif
+		void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | huge_flags, -1, 0);
+		if (ptr != MAP_FAILED)
+			return ptr;
+		explicit_pages_unavailable_.store(true, std::memory_order_relaxed);
+	}
+#endif
+
+	void* ptr = map_aligned(size);
+	if (!ptr)
+		throw std::bad_alloc();
+
+#if defined(MADV_HUGEPAGE)
+	// failure only means normal pages
+	::madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+	return ptr;
+#else
+	throw std::bad_alloc();
+#endif
+}
+
+inline void* huge_page_resource::map_aligned([[maybe_unused]] size_type size) noexcept
+{
+#if defined(__linux__)
+	// over-map by a huge page to align the start, then trim both ends
+	void* mapped = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapped == MAP_FAILED)
+		return nullptr;
+
+	auto address = reinterpret_cast<std::uintptr_t>(mapped);
+	auto aligned = (address + huge_page_size - 1) & ~std::uintptr_t(huge_page_size - 1);
+	auto* start = static_cast<std::byte*>(mapped);
+	auto* ptr = start + (aligned - address);
+	if (ptr != start)
+		::munmap(start, ptr - start);
+	if (auto tail = huge_page_size - (ptr - start))
+		::munmap(ptr + size, tail);
+	return ptr;
+#else
+	return nullptr;
+#endif
+}
+
+template<typename T>
+inline T* huge_page_allocator<T>::allocate(size_type count)
+{
+	if (count > std::size_t(-1) / 2 / sizeof(T))
+		throw std::bad_array_new_length();
+
+	return static_cast<T*>(huge_page_resource::allocate(count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+inline void huge_page_allocator<T>::deallocate(T* ptr, size_type count) noexcept
+{
+	huge_page_resource::deallocate(ptr, count * sizeof(T), alignof(T));
+}
+
+template<typename T>
+inline T* huge_page_allocator<T>::reallocate(T* ptr, size_type old_count, size_type new_count)
+	requires is_trivially_relocatable_v<T>
+{
+	if (new_count > std::size_t(-1) / 2 / sizeof(T))
+		throw std::bad_array_new_length();
+
+	return static_cast<T*>(huge_page_resource::reallocate(ptr, old_count * sizeof(T), new_count * sizeof(T), alignof(T)));
+}
+
+} // namespace stc
@@ -0,0 +1,338 @@
+#pragma once
+#include "../include/stc/mapped_swap_back_array.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stc
+{
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>::mapped_swap_back_array(const std::filesystem::path& path, open_check check)
+{
+	auto throw_errno = [&](const char* what)
+	{
+		int error = errno;
+		close();
+		throw std::system_error(error, std::generic_category(), std::string("mapped_swap_back_array: ") + what + " " + path.string());
+	};
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd_ < 0)
+		throw_errno("cannot open");
+
+	struct stat status {};
+	if (::fstat(fd_, &status) != 0)
+		throw_errno("cannot stat");
+
+	if (status.st_size == 0)
+	{
+		// new file
+		if (::ftruncate(fd_, off_t(header_size + default_capacity * sizeof(T))) != 0)
+			throw_errno("cannot resize");
+		mapping_size_ = header_size + default_capacity * sizeof(T);
+	}
+	else
+	{
+		mapping_size_ = size_type(status.st_size);
+	}
+
+	void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (mapping == MAP_FAILED)
+	{
+		mapping_size_ = 0;
+		throw_errno("cannot map");
+	}
+	mapping_ = static_cast<std::byte*>(mapping);
+	data_ = reinterpret_cast<T*>(mapping_ + header_size);
+
+	if (status.st_size == 0)
+	{
+		header() = file_header{file_magic, file_version, sizeof(T), alignof(T), 0, default_capacity, 0};
+		header().checksum = compute_checksum();
+		return;
+	}
+
+	try
+	{
+		validate(mapping_size_, check);
+	}
+	catch (...)
+	{
+		// leave the file as it was
+		::munmap(mapping_, mapping_size_);
+		mapping_ = nullptr;
+		close();
+		throw;
+	}
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>::mapped_swap_back_array(mapped_swap_back_array&& other) noexcept
+	: fd_(std::exchange(other.fd_, -1))
+	, mapping_(std::exchange(other.mapping_, nullptr))
+	, mapping_size_(std::exchange(other.mapping_size_, 0))
+	, data_(std::exchange(other.data_, nullptr))
+{
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>& mapped_swap_back_array<T>::operator=(mapped_swap_back_array&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		fd_ = std::exchange(other.fd_, -1);
+		mapping_ = std::exchange(other.mapping_, nullptr);
+		mapping_size_ = std::exchange(other.mapping_size_, 0);
+		data_ = std::exchange(other.data_, nullptr);
+	}
+	return *this;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>::~mapped_swap_back_array()
+{
+	close();
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>::size_type mapped_swap_back_array<T>::size() const noexcept
+{
+	return mapping_ ? size_type(header().size) : 0;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline mapped_swap_back_array<T>::size_type mapped_swap_back_array<T>::capacity() const noexcept
+{
+	return mapping_ ? size_type(header().capacity) : 0;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::reserve(size_type new_capacity)
+{
+	if (new_capacity > capacity())
+		remap(new_capacity);
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::clear() noexcept
+{
+	header().size = 0;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+template<typename... Args>
+inline T& mapped_swap_back_array<T>::emplace_back(Args&&... args)
+{
+	auto size = this->size();
+	if (size == capacity())
+	{
+		// args may refer to an existing element, which growth can move
+		T value(std::forward<Args>(args)...);
+		remap(std::max(capacity() * 2, default_capacity));
+		std::construct_at(data_ + size, value);
+	}
+	else
+	{
+		std::construct_at(data_ + size, std::forward<Args>(args)...);
+	}
+
+	header().size = size + 1;
+	return data_[size];
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::pop_back() noexcept
+{
+	assert(!empty());
+
+	--header().size;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::erase_swap(size_type element_index) noexcept
+{
+	assert(element_index < size());
+
+	auto last_index = size() - 1;
+	if (element_index != last_index)
+		data_[element_index] = data_[last_index];
+	header().size = last_index;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::erase_swap(size_type start_index, size_type count) noexcept
+{
+	assert(start_index + count <= size());
+
+	// fill the holes left before the new end with the tail block, in order
+	auto size = this->size();
+	auto new_size = size - count;
+	auto moved_count = start_index < new_size ? std::min(count, new_size - start_index) : 0;
+	if (moved_count != 0)
+		std::memcpy(static_cast<void*>(data_ + start_index), static_cast<const void*>(data_ + size - moved_count), moved_count * sizeof(T));
+	header().size = new_size;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+template<std::predicate<T&> Pred>
+inline mapped_swap_back_array<T>::size_type mapped_swap_back_array<T>::erase_swap_if(Pred pred)
+{
+	T* items = data();
+	auto new_size = swap_partition(size_type(0), size(),
+		[&](size_type i) { return static_cast<bool>(pred(items[i])); },
+		[&](size_type to, size_type from) { items[to] = items[from]; });
+
+	auto removed = size() - new_size;
+	header().size = new_size;
+	return removed;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::sync()
+{
+	header().checksum = compute_checksum();
+	if (::msync(mapping_, mapping_size_, MS_SYNC) != 0)
+		throw std::system_error(errno, std::generic_category(), "mapped_swap_back_array: cannot sync");
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline bool mapped_swap_back_array<T>::verify_checksum() const noexcept
+{
+	return header().checksum == compute_checksum();
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::remap(size_type capacity)
+{
+	auto new_size = header_size + capacity * sizeof(T);
+	if (::ftruncate(fd_, off_t(new_size)) != 0)
+		throw std::system_error(errno, std::generic_category(), "mapped_swap_back_array: cannot resize the file");
+
+#if defined(__linux__)
+	void* mapping = ::mremap(mapping_, mapping_size_, new_size, MREMAP_MAYMOVE);
+#else
+	void* mapping = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (mapping != MAP_FAILED)
+		::munmap(mapping_, mapping_size_);
+#endif
+	if (mapping == MAP_FAILED)
+	{
+		int error = errno;
+		(void)::ftruncate(fd_, off_t(mapping_size_));
+		throw std::system_error(error, std::generic_category(), "mapped_swap_back_array: cannot map the file");
+	}
+
+	mapping_ = static_cast<std::byte*>(mapping);
+	mapping_size_ = new_size;
+	data_ = reinterpret_cast<T*>(mapping_ + header_size);
+	header().capacity = capacity;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::validate(size_type file_size, open_check check) const
+{
+	auto fail = [](const char* reason)
+	{
+		throw std::runtime_error(std::string("mapped_swap_back_array: ") + reason);
+	};
+
+	if (file_size < header_size)
+		fail("file too small for a header");
+
+	auto& h = header();
+	if (h.magic != file_magic)
+		fail("not a mapped_swap_back_array file");
+	if (h.version != file_version)
+		fail("unsupported file version");
+	if (h.element_size != sizeof(T) || h.element_alignment != alignof(T))
+		fail("element type mismatch");
+	if (h.size > h.capacity || h.capacity > (file_size - header_size) / sizeof(T))
+		fail("size or capacity past the end of the file");
+	if (check == open_check::checksum && h.checksum != compute_checksum())
+		fail("checksum mismatch, the file was not closed cleanly or is corrupted");
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline std::uint64_t mapped_swap_back_array<T>::compute_checksum() const noexcept
+{
+	// four independent multiply-xorshift lanes over 8-byte words, fast but not cryptographic
+	constexpr std::uint64_t multiplier = 0x9E37'79B9'7F4A'7C15;
+	auto mix = [](std::uint64_t hash, std::uint64_t word)
+	{
+		hash = (hash ^ word) * multiplier;
+		return hash ^ (hash >> 29);
+	};
+
+	auto size = header().size;
+	auto* bytes = reinterpret_cast<const std::byte*>(data_);
+	auto byte_count = size_type(size) * sizeof(T);
+
+	std::uint64_t lanes[4] = {size, sizeof(T), 1, 2};
+	size_type offset = 0;
+	for (; offset + 32 <= byte_count; offset += 32)
+	{
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			std::uint64_t word;
+			std::memcpy(&word, bytes + offset + lane * 8, 8);
+			lanes[lane] = mix(lanes[lane], word);
+		}
+	}
+
+	std::uint64_t hash = mix(mix(mix(lanes[0], lanes[1]), lanes[2]), lanes[3]);
+	for (; offset < byte_count; ++offset)
+		hash = mix(hash, std::uint64_t(bytes[offset]));
+	return hash;
+}
+
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+inline void mapped_swap_back_array<T>::close() noexcept
+{
+	if (mapping_)
+	{
+		header().checksum = compute_checksum();
+		::munmap(mapping_, mapping_size_);
+		mapping_ = nullptr;
+		mapping_size_ = 0;
+		data_ = nullptr;
+	}
+
+	if (fd_ >= 0)
+	{
+		::close(fd_);
+		fd_ = -1;
+	}
+}
+
+} // namespace stc
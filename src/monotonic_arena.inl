@@ -0,0 +1,139 @@
+#pragma once
+#include "../include/stc/monotonic_arena.h"
+#include <algorithm>
+#include <memory>
+
+namespace stc
+{
+
+inline monotonic_arena::monotonic_arena(size_type initial_block_size) noexcept
+	: next_block_size_(std::max<size_type>(initial_block_size, sizeof(block) * 2))
+{
+}
+
+inline monotonic_arena::~monotonic_arena()
+{
+	release();
+}
+
+inline void* monotonic_arena::allocate(size_type bytes, size_type alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	void* ptr = cursor_;
+	size_type space = end_ - cursor_;
+	if (!cursor_ || !std::align(alignment, bytes, ptr, space))
+	{
+		add_block(bytes, alignment);
+		ptr = cursor_;
+		space = end_ - cursor_;
+		std::align(alignment, bytes, ptr, space);
+	}
+
+	last_allocation_ = static_cast<std::byte*>(ptr);
+	cursor_ = last_allocation_ + bytes;
+	return ptr;
+}
+
+inline void monotonic_arena::deallocate(void* ptr, size_type bytes) noexcept
+{
+	// only the most recent allocation can be given back
+	if (ptr == last_allocation_ && static_cast<std::byte*>(ptr) + bytes == cursor_)
+	{
+		cursor_ = last_allocation_;
+		last_allocation_ = nullptr;
+	}
+}
+
+inline void monotonic_arena::reset() noexcept
+{
+	if (!current_)
+		return;
+
+	// keep the largest block, release the others
+	auto previous_capacity = capacity_;
+	block* largest = current_;
+	for (block* b = current_; b; b = b->previous)
+	{
+		if (b->size > largest->size)
+			largest = b;
+	}
+
+	for (block* b = current_; b;)
+	{
+		block* previous = b->previous;
+		if (b != largest)
+		{
+			capacity_ -= b->size;
+			free_block(b);
+		}
+		b = previous;
+	}
+
+	// the next block can hold everything the released blocks did, so a repeated workload settles in one block
+	next_block_size_ = std::max(next_block_size_, previous_capacity);
+
+	largest->previous = nullptr;
+	current_ = largest;
+	cursor_ = reinterpret_cast<std::byte*>(largest + 1);
+	end_ = reinterpret_cast<std::byte*>(largest) + largest->size;
+	last_allocation_ = nullptr;
+}
+
+inline void monotonic_arena::release() noexcept
+{
+	for (block* b = current_; b;)
+	{
+		block* previous = b->previous;
+		free_block(b);
+		b = previous;
+	}
+
+	current_ = nullptr;
+	cursor_ = end_ = last_allocation_ = nullptr;
+	capacity_ = 0;
+}
+
+inline void monotonic_arena::add_block(size_type bytes, size_type alignment)
+{
+	// the block must fit the header, the allocation and its worst case alignment padding
+	auto padding = alignment > block_alignment ? alignment : 0;
+	if (bytes > std::size_t(-1) - sizeof(block) - padding)
+		throw std::bad_alloc();
+
+	auto needed = sizeof(block) + bytes + padding;
+	auto size = std::max(next_block_size_, needed);
+
+	auto* b = static_cast<block*>(::operator new(size));
+	b->previous = current_;
+	b->size = size;
+
+	current_ = b;
+	cursor_ = reinterpret_cast<std::byte*>(b + 1);
+	end_ = reinterpret_cast<std::byte*>(b) + size;
+	capacity_ += size;
+	++upstream_allocations_;
+	next_block_size_ = size * 2;
+}
+
+inline void monotonic_arena::free_block(block* b) noexcept
+{
+	::operator delete(static_cast<void*>(b));
+}
+
+template<typename T>
+inline T* arena_allocator<T>::allocate(size_type count)
+{
+	if (count > std::size_t(-1) / sizeof(T))
+		throw std::bad_array_new_length();
+
+	return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+inline void arena_allocator<T>::deallocate(T* ptr, size_type count) noexcept
+{
+	arena_->deallocate(ptr, count * sizeof(T));
+}
+
+} // namespace stc
@@ -0,0 +1,69 @@
+#pragma once
+#include "../include/stc/pool_allocator.h"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace stc
+{
+
+inline void* pool_resource::allocate(size_type bytes, size_type alignment)
+{
+	// the largest size class is half of the address space
+	if (bytes > std::size_t(-1) / 2 + 1)
+		throw std::bad_alloc();
+
+	auto index = size_class(bytes, alignment);
+	if (free_block* reused = free_lists_[index])
+	{
+		free_lists_[index] = reused->next;
+		return reused;
+	}
+
+	auto block_size = size_type(1) << index;
+	return arena_.allocate(block_size, std::min(block_size, max_alignment));
+}
+
+inline void pool_resource::deallocate(void* ptr, size_type bytes, size_type alignment) noexcept
+{
+	auto index = size_class(bytes, alignment);
+	auto* freed = static_cast<free_block*>(ptr);
+	freed->next = free_lists_[index];
+	free_lists_[index] = freed;
+}
+
+inline void pool_resource::reset() noexcept
+{
+	free_lists_.fill(nullptr);
+	arena_.reset();
+}
+
+inline void pool_resource::release() noexcept
+{
+	free_lists_.fill(nullptr);
+	arena_.release();
+}
+
+inline pool_resource::size_type pool_resource::size_class(size_type bytes, size_type alignment) noexcept
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= max_alignment);
+
+	return std::bit_width(std::max({bytes, alignment, min_block_size}) - 1);
+}
+
+template<typename T>
+inline T* pool_allocator<T>::allocate(size_type count)
+{
+	if (count > std::size_t(-1) / 2 / sizeof(T))
+		throw std::bad_array_new_length();
+
+	return static_cast<T*>(pool_->allocate(count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+inline void pool_allocator<T>::deallocate(T* ptr, size_type count) noexcept
+{
+	pool_->deallocate(ptr, count * sizeof(T), alignof(T));
+}
+
+} // namespace stc
@@ -0,0 +1,325 @@
+#pragma once
+#include "../include/stc/segmented_swap_back_array.h"
+#include <algorithm>
+
+namespace stc
+{
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::segmented_swap_back_array(const Allocator& alloc) noexcept
+	: alloc_(alloc)
+{
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::segmented_swap_back_array(size_type count, const T& value, const Allocator& alloc)
+	: alloc_(alloc)
+{
+	resize(count, value);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::segmented_swap_back_array(std::initializer_list<T> ilist, const Allocator& alloc)
+	: alloc_(alloc)
+{
+	reserve(ilist.size());
+	for (const T& value : ilist)
+		emplace_back(value);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::segmented_swap_back_array(const segmented_swap_back_array& other)
+	: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+	reserve(other.size_);
+	for (const T& value : other)
+		emplace_back(value);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::segmented_swap_back_array(segmented_swap_back_array&& other) noexcept
+	: chunks_(std::move(other.chunks_))
+	, size_(std::exchange(other.size_, 0))
+	, alloc_(std::move(other.alloc_))
+{
+	other.chunks_.clear();
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::~segmented_swap_back_array()
+{
+	release();
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>& segmented_swap_back_array<T, ChunkSize, Allocator>::operator=(const segmented_swap_back_array& other)
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+	if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+	{
+		if (alloc_ != other.alloc_)
+			release(); // chunks must be released by the allocator that provided them
+		alloc_ = other.alloc_;
+	}
+
+	reserve(other.size_);
+	for (const T& value : other)
+		emplace_back(value);
+	return *this;
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>& segmented_swap_back_array<T, ChunkSize, Allocator>::operator=(segmented_swap_back_array&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+{
+	if (this == &other)
+		return *this;
+
+	if (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value || alloc_ == other.alloc_)
+	{
+		release();
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+			alloc_ = std::move(other.alloc_);
+		chunks_ = std::move(other.chunks_);
+		size_ = std::exchange(other.size_, 0);
+		other.chunks_.clear();
+	}
+	else
+	{
+		// chunks cannot change hands, move the elements one by one
+		clear();
+		reserve(other.size_);
+		for (T& value : other)
+			emplace_back(std::move(value));
+		other.clear();
+	}
+	return *this;
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>& segmented_swap_back_array<T, ChunkSize, Allocator>::operator=(std::initializer_list<T> ilist)
+{
+	clear();
+	reserve(ilist.size());
+	for (const T& value : ilist)
+		emplace_back(value);
+	return *this;
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline T& segmented_swap_back_array<T, ChunkSize, Allocator>::at(size_type index)
+{
+	if (index >= size_)
+		throw std::out_of_range("segmented_swap_back_array::at: index out of range");
+	return (*this)[index];
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline const T& segmented_swap_back_array<T, ChunkSize, Allocator>::at(size_type index) const
+{
+	if (index >= size_)
+		throw std::out_of_range("segmented_swap_back_array::at: index out of range");
+	return (*this)[index];
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline std::span<T> segmented_swap_back_array<T, ChunkSize, Allocator>::chunk(size_type chunk_index) noexcept
+{
+	assert(chunk_index < chunk_count());
+
+	auto first = chunk_index * ChunkSize;
+	return {chunks_[chunk_index], std::min(ChunkSize, size_ - first)};
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline std::span<const T> segmented_swap_back_array<T, ChunkSize, Allocator>::chunk(size_type chunk_index) const noexcept
+{
+	assert(chunk_index < chunk_count());
+
+	auto first = chunk_index * ChunkSize;
+	return {chunks_[chunk_index], std::min(ChunkSize, size_ - first)};
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::reserve(size_type new_capacity)
+{
+	auto new_chunk_count = (new_capacity + ChunkSize - 1) / ChunkSize;
+	if (new_chunk_count <= chunks_.size())
+		return;
+
+	chunks_.reserve(new_chunk_count);
+	while (chunks_.size() < new_chunk_count)
+		chunks_.push_back(alloc_traits::allocate(alloc_, ChunkSize));
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::shrink_to_fit() noexcept
+{
+	while (chunks_.size() > chunk_count())
+	{
+		alloc_traits::deallocate(alloc_, chunks_.back(), ChunkSize);
+		chunks_.pop_back();
+	}
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::clear() noexcept
+{
+	destroy_back(size_);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+template<typename... Args>
+inline T& segmented_swap_back_array<T, ChunkSize, Allocator>::emplace_back(Args&&... args)
+{
+	if (size_ == capacity())
+	{
+		// only the new chunk is allocated, elements stay in place
+		T* new_chunk = alloc_traits::allocate(alloc_, ChunkSize);
+		try
+		{
+			chunks_.push_back(new_chunk);
+		}
+		catch (...)
+		{
+			alloc_traits::deallocate(alloc_, new_chunk, ChunkSize);
+			throw;
+		}
+	}
+
+	T* element = chunks_[size_ / ChunkSize] + size_ % ChunkSize;
+	alloc_traits::construct(alloc_, element, std::forward<Args>(args)...);
+	++size_;
+	return *element;
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::pop_back() noexcept
+{
+	assert(size_ > 0);
+
+	destroy_back(1);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::resize(size_type count)
+{
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	reserve(count);
+	while (size_ < count)
+		emplace_back();
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::resize(size_type count, const T& value)
+{
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	reserve(count);
+	while (size_ < count)
+		emplace_back(value);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(element_index < size_);
+
+	if (element_index + 1 != size_)
+	{
+		// move element if its not already the last
+		(*this)[element_index] = std::move(back());
+	}
+	pop_back();
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(start_index + count <= size_);
+
+	// holes below the new size are filled with the same number of elements from the end, in order
+	auto new_size = size_ - count;
+	auto moved_count = new_size > start_index ? std::min(count, new_size - start_index) : 0;
+	auto moved_from = size_ - moved_count;
+	for (size_type i = 0; i < moved_count; ++i)
+		(*this)[start_index + i] = std::move((*this)[moved_from + i]);
+
+	destroy_back(count);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::iterator segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap(const_iterator it) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(it.index() < size_);
+
+	auto index = it.index();
+	erase_swap(index);
+	return {this, std::min(index, size_)};
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::iterator segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(first.index() <= last.index() && last.index() <= size_);
+
+	auto index = first.index();
+	erase_swap(index, last.index() - index);
+	return {this, std::min(index, size_)};
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+template<std::predicate<T&> Pred>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::size_type segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap_if(Pred pred)
+{
+	return erase_swap_if(begin(), end(), pred);
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+template<std::predicate<T&> Pred>
+inline segmented_swap_back_array<T, ChunkSize, Allocator>::size_type segmented_swap_back_array<T, ChunkSize, Allocator>::erase_swap_if(const_iterator first, const_iterator last, Pred pred)
+{
+	assert(first.index() <= last.index() && last.index() <= size_);
+
+	auto last_index = last.index();
+	auto new_last = swap_partition(first.index(), last_index,
+		[&](size_type i) { return static_cast<bool>(pred((*this)[i])); },
+		[&](size_type to, size_type from) { (*this)[to] = std::move((*this)[from]); });
+
+	erase_swap(new_last, last_index - new_last);
+	return last_index - new_last;
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::destroy_back(size_type count) noexcept
+{
+	assert(count <= size_);
+
+	for (; count > 0; --count)
+	{
+		--size_;
+		alloc_traits::destroy(alloc_, chunks_[size_ / ChunkSize] + size_ % ChunkSize);
+	}
+}
+
+template<typename T, std::size_t ChunkSize, typename Allocator>
+inline void segmented_swap_back_array<T, ChunkSize, Allocator>::release() noexcept
+{
+	clear();
+	for (T* chunk : chunks_)
+		alloc_traits::deallocate(alloc_, chunk, ChunkSize);
+	chunks_.clear();
+}
+
+} // namespace stc
@@ -0,0 +1,305 @@
+#pragma once
+#include "../include/stc/simd_search.h"
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+#define STC_SIMD_SEARCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define STC_SIMD_SEARCH_TARGET(isa)
+#else
+#define STC_SIMD_SEARCH_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace stc
+{
+
+inline simd_search::level simd_search::supported_level() noexcept
+{
+	static const level detected = detect_level();
+	return detected;
+}
+
+template<simd_searchable T>
+inline std::size_t simd_search::find(const T* data, std::size_t count, T value) noexcept
+{
+	return find(data, count, value, supported_level());
+}
+
+template<simd_searchable T>
+inline std::size_t simd_search::find(const T* data, std::size_t count, T value, level kernel_level) noexcept
+{
+	assert(kernel_level <= supported_level());
+
+#if defined(STC_SIMD_SEARCH_X86)
+	switch (kernel_level)
+	{
+	case level::avx512:
+		return find_avx512(data, count, value);
+	case level::avx2:
+		return find_avx2(data, count, value);
+	case level::sse2:
+		return find_sse2(data, count, value);
+	default:
+		break;
+	}
+#endif
+
+	return find_portable(data, count, value);
+}
+
+inline simd_search::level simd_search::detect_level() noexcept
+{
+#if defined(STC_SIMD_SEARCH_X86) && defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	int max_leaf = info[0];
+
+	// the OS must save the AVX registers, and the AVX-512 ones, on context switches
+	__cpuidex(info, 1, 0);
+	bool os_saves_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x06) == 0x06;
+	if (!os_saves_avx || max_leaf < 7)
+		return level::sse2;
+
+	bool os_saves_avx512 = (_xgetbv(0) & 0xe6) == 0xe6;
+	__cpuidex(info, 7, 0);
+	if (os_saves_avx512 && (info[1] & (1 << 16)) && (info[1] & (1 << 30)))
+		return level::avx512;
+	if (info[1] & (1 << 5))
+		return level::avx2;
+	return level::sse2;
+#elif defined(STC_SIMD_SEARCH_X86)
+	// also checks that the OS saves the registers
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+		return level::avx512;
+	if (__builtin_cpu_supports("avx2"))
+		return level::avx2;
+	return level::sse2;
+#else
+	return level::portable;
+#endif
+}
+
+template<typename T>
+inline std::size_t simd_search::find_portable(const T* data, std::size_t count, T value) noexcept
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (data[i] == value)
+			return i;
+	}
+	return count;
+}
+
+#if defined(STC_SIMD_SEARCH_X86)
+
+template<typename T, typename Vector>
+STC_SIMD_SEARCH_TARGET("sse2")
+inline Vector simd_search::equal_sse2(Vector a, Vector b) noexcept
+{
+	if constexpr (sizeof(T) == 1)
+		return _mm_cmpeq_epi8(a, b);
+	else if constexpr (sizeof(T) == 2)
+		return _mm_cmpeq_epi16(a, b);
+	else if constexpr (sizeof(T) == 4)
+		return _mm_cmpeq_epi32(a, b);
+	else
+	{
+		// no 64-bit comparison before SSE4.1, both halves must be equal
+		auto halves = _mm_cmpeq_epi32(a, b);
+		return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+	}
+}
+
+template<typename T>
+STC_SIMD_SEARCH_TARGET("sse2")
+inline std::size_t simd_search::find_sse2(const T* data, std::size_t count, T value) noexcept
+{
+	constexpr std::size_t lanes = sizeof(__m128i) / sizeof(T);
+
+	__m128i needle;
+	if constexpr (sizeof(T) == 1)
+		needle = _mm_set1_epi8(std::bit_cast<char>(value));
+	else if constexpr (sizeof(T) == 2)
+		needle = _mm_set1_epi16(std::bit_cast<short>(value));
+	else if constexpr (sizeof(T) == 4)
+		needle = _mm_set1_epi32(std::bit_cast<int>(value));
+	else
+		needle = _mm_set1_epi64x(std::bit_cast<long long>(value));
+
+	std::size_t i = 0;
+	if constexpr (sizeof(T) == 8)
+	{
+		// gathers the low and high halves of two vectors, so that a single AND checks four elements
+		for (; i + 4 * lanes <= count; i += 4 * lanes)
+		{
+			auto block = reinterpret_cast<const __m128i*>(data + i);
+			__m128 halves[4];
+			for (int v = 0; v < 4; ++v)
+				halves[v] = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(block + v), needle));
+
+			auto first = _mm_and_ps(_mm_shuffle_ps(halves[0], halves[1], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(halves[0], halves[1], _MM_SHUFFLE(3, 1, 3, 1)));
+			auto second = _mm_and_ps(_mm_shuffle_ps(halves[2], halves[3], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(halves[2], halves[3], _MM_SHUFFLE(3, 1, 3, 1)));
+			if (auto mask = unsigned(_mm_movemask_ps(first)) | unsigned(_mm_movemask_ps(second)) << 4)
+				return i + std::countr_zero(mask);
+		}
+	}
+	else
+	{
+		// the byte mask of a vector holds sizeof(T) bits per equal lane
+		for (; i + 4 * lanes <= count; i += 4 * lanes)
+		{
+			auto block = reinterpret_cast<const __m128i*>(data + i);
+			__m128i equal[4];
+			for (int v = 0; v < 4; ++v)
+				equal[v] = equal_sse2<T>(_mm_loadu_si128(block + v), needle);
+
+			auto any = _mm_or_si128(_mm_or_si128(equal[0], equal[1]), _mm_or_si128(equal[2], equal[3]));
+			if (_mm_movemask_epi8(any) == 0)
+				continue;
+
+			for (int v = 0; v < 4; ++v)
+			{
+				if (auto mask = unsigned(_mm_movemask_epi8(equal[v])))
+					return i + v * lanes + std::countr_zero(mask) / sizeof(T);
+			}
+		}
+	}
+
+	for (; i + lanes <= count; i += lanes)
+	{
+		auto equal = equal_sse2<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+		if (auto mask = unsigned(_mm_movemask_epi8(equal)))
+			return i + std::countr_zero(mask) / sizeof(T);
+	}
+
+	return i + find_portable(data + i, count - i, value);
+}
+
+template<typename T, typename Vector>
+STC_SIMD_SEARCH_TARGET("avx2")
+inline Vector simd_search::equal_avx2(Vector a, Vector b) noexcept
+{
+	if constexpr (sizeof(T) == 1)
+		return _mm256_cmpeq_epi8(a, b);
+	else if constexpr (sizeof(T) == 2)
+		return _mm256_cmpeq_epi16(a, b);
+	else if constexpr (sizeof(T) == 4)
+		return _mm256_cmpeq_epi32(a, b);
+	else
+		return _mm256_cmpeq_epi64(a, b);
+}
+
+template<typename T>
+STC_SIMD_SEARCH_TARGET("avx2")
+inline std::size_t simd_search::find_avx2(const T* data, std::size_t count, T value) noexcept
+{
+	constexpr std::size_t lanes = sizeof(__m256i) / sizeof(T);
+
+	__m256i needle;
+	if constexpr (sizeof(T) == 1)
+		needle = _mm256_set1_epi8(std::bit_cast<char>(value));
+	else if constexpr (sizeof(T) == 2)
+		needle = _mm256_set1_epi16(std::bit_cast<short>(value));
+	else if constexpr (sizeof(T) == 4)
+		needle = _mm256_set1_epi32(std::bit_cast<int>(value));
+	else
+		needle = _mm256_set1_epi64x(std::bit_cast<long long>(value));
+
+	std::size_t i = 0;
+	for (; i + 4 * lanes <= count; i += 4 * lanes)
+	{
+		auto block = reinterpret_cast<const __m256i*>(data + i);
+		__m256i equal[4];
+		for (int v = 0; v < 4; ++v)
+			equal[v] = equal_avx2<T>(_mm256_loadu_si256(block + v), needle);
+
+		auto any = _mm256_or_si256(_mm256_or_si256(equal[0], equal[1]), _mm256_or_si256(equal[2], equal[3]));
+		if (_mm256_testz_si256(any, any))
+			continue;
+
+		for (int v = 0; v < 4; ++v)
+		{
+			if (auto mask = unsigned(_mm256_movemask_epi8(equal[v])))
+				return i + v * lanes + std::countr_zero(mask) / sizeof(T);
+		}
+	}
+
+	for (; i + lanes <= count; i += lanes)
+	{
+		auto equal = equal_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+		if (auto mask = unsigned(_mm256_movemask_epi8(equal)))
+			return i + std::countr_zero(mask) / sizeof(T);
+	}
+
+	return i + find_portable(data + i, count - i, value);
+}
+
+template<typename T, typename Vector>
+STC_SIMD_SEARCH_TARGET("avx512f,avx512bw")
+inline std::uint64_t simd_search::equal_avx512(Vector a, Vector b) noexcept
+{
+	if constexpr (sizeof(T) == 1)
+		return _mm512_cmpeq_epi8_mask(a, b);
+	else if constexpr (sizeof(T) == 2)
+		return _mm512_cmpeq_epi16_mask(a, b);
+	else if constexpr (sizeof(T) == 4)
+		return _mm512_cmpeq_epi32_mask(a, b);
+	else
+		return _mm512_cmpeq_epi64_mask(a, b);
+}
+
+template<typename T>
+STC_SIMD_SEARCH_TARGET("avx512f,avx512bw")
+inline std::size_t simd_search::find_avx512(const T* data, std::size_t count, T value) noexcept
+{
+	constexpr std::size_t lanes = sizeof(__m512i) / sizeof(T);
+
+	__m512i needle;
+	if constexpr (sizeof(T) == 1)
+		needle = _mm512_set1_epi8(std::bit_cast<char>(value));
+	else if constexpr (sizeof(T) == 2)
+		needle = _mm512_set1_epi16(std::bit_cast<short>(value));
+	else if constexpr (sizeof(T) == 4)
+		needle = _mm512_set1_epi32(std::bit_cast<int>(value));
+	else
+		needle = _mm512_set1_epi64(std::bit_cast<long long>(value));
+
+	// the comparisons give one bit per lane
+	std::size_t i = 0;
+	for (; i + 4 * lanes <= count; i += 4 * lanes)
+	{
+		std::uint64_t equal[4];
+		for (int v = 0; v < 4; ++v)
+			equal[v] = equal_avx512<T>(_mm512_loadu_si512(data + i + v * lanes), needle);
+
+		if ((equal[0] | equal[1] | equal[2] | equal[3]) == 0)
+			continue;
+
+		for (int v = 0; v < 4; ++v)
+		{
+			if (equal[v])
+				return i + v * lanes + std::countr_zero(equal[v]);
+		}
+	}
+
+	for (; i + lanes <= count; i += lanes)
+	{
+		if (auto equal = equal_avx512<T>(_mm512_loadu_si512(data + i), needle))
+			return i + std::countr_zero(equal);
+	}
+
+	return i + find_portable(data + i, count - i, value);
+}
+
+#endif
+
+} // namespace stc
+
+#undef STC_SIMD_SEARCH_TARGET
+#undef STC_SIMD_SEARCH_X86
@@ -0,0 +1,133 @@
+#pragma once
+#include "../include/stc/slot_map.h"
+
+namespace stc
+{
+
+template<typename T, typename Allocator>
+inline constexpr slot_map<T, Allocator>::slot_map(const Allocator& alloc)
+	: values_(alloc)
+	, dense_to_slot_(index_allocator(alloc))
+	, slots_(slot_allocator(alloc))
+{
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+inline constexpr slot_map<T, Allocator>::handle slot_map<T, Allocator>::emplace(Args&&... args)
+{
+	if (free_head_ == no_free_slot)
+	{
+		// grow the slot table, the new slot is left free if anything below throws
+		assert(slots_.size() < no_free_slot);
+		slots_.push_back({no_free_slot, 0});
+		free_head_ = static_cast<std::uint32_t>(slots_.size() - 1);
+	}
+
+	auto slot_index = free_head_;
+	values_.emplace_back(std::forward<Args>(args)...);
+	try
+	{
+		dense_to_slot_.push_back(slot_index);
+	}
+	catch (...)
+	{
+		values_.pop_back();
+		throw;
+	}
+
+	auto& s = slots_[slot_index];
+	free_head_ = s.index;
+	s.index = static_cast<std::uint32_t>(values_.size() - 1);
+	return {slot_index, s.generation};
+}
+
+template<typename T, typename Allocator>
+inline constexpr bool slot_map<T, Allocator>::erase(handle h)
+{
+	if (!contains(h))
+		return false;
+
+	auto& s = slots_[h.index];
+	auto dense_index = s.index;
+	values_.erase_swap(dense_index);
+	dense_to_slot_.erase_swap(dense_index);
+
+	if (dense_index < values_.size())
+	{
+		// the last element was moved into the hole
+		slots_[dense_to_slot_[dense_index]].index = dense_index;
+	}
+
+	++s.generation;
+	s.index = free_head_;
+	free_head_ = h.index;
+	return true;
+}
+
+template<typename T, typename Allocator>
+inline constexpr bool slot_map<T, Allocator>::contains(handle h) const noexcept
+{
+	// a slot generation changes on removal, so a free slot never matches an issued handle
+	return h.index < slots_.size() && slots_[h.index].generation == h.generation;
+}
+
+template<typename T, typename Allocator>
+inline constexpr T* slot_map<T, Allocator>::find(handle h) noexcept
+{
+	return contains(h) ? &values_[slots_[h.index].index] : nullptr;
+}
+
+template<typename T, typename Allocator>
+inline constexpr const T* slot_map<T, Allocator>::find(handle h) const noexcept
+{
+	return contains(h) ? &values_[slots_[h.index].index] : nullptr;
+}
+
+template<typename T, typename Allocator>
+inline constexpr T& slot_map<T, Allocator>::operator[](handle h) noexcept
+{
+	assert(contains(h) && "Accessing element through a stale handle.");
+	return values_[slots_[h.index].index];
+}
+
+template<typename T, typename Allocator>
+inline constexpr const T& slot_map<T, Allocator>::operator[](handle h) const noexcept
+{
+	assert(contains(h) && "Accessing element through a stale handle.");
+	return values_[slots_[h.index].index];
+}
+
+template<typename T, typename Allocator>
+inline constexpr slot_map<T, Allocator>::handle slot_map<T, Allocator>::handle_at(size_type dense_index) const noexcept
+{
+	assert(dense_index < values_.size());
+
+	auto slot_index = dense_to_slot_[dense_index];
+	return {slot_index, slots_[slot_index].generation};
+}
+
+template<typename T, typename Allocator>
+inline constexpr void slot_map<T, Allocator>::clear() noexcept
+{
+	for (auto slot_index : dense_to_slot_)
+	{
+		auto& s = slots_[slot_index];
+		++s.generation;
+		s.index = free_head_;
+		free_head_ = slot_index;
+	}
+
+	values_.clear();
+	dense_to_slot_.clear();
+}
+
+template<typename T, typename Allocator>
+inline constexpr void slot_map<T, Allocator>::reserve(size_type new_capacity)
+{
+	values_.reserve(new_capacity);
+	dense_to_slot_.reserve(new_capacity);
+	slots_.reserve(new_capacity);
+}
+
+} // namespace stc
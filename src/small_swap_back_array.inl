@@ -0,0 +1,444 @@
+#pragma once
+#include "../include/stc/small_swap_back_array.h"
+#include <algorithm>
+
+namespace stc
+{
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::small_swap_back_array(const Allocator& alloc) noexcept
+	: alloc_(alloc)
+{
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::small_swap_back_array(size_type count, const T& value, const Allocator& alloc)
+	: alloc_(alloc)
+{
+	resize(count, value);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::small_swap_back_array(std::initializer_list<T> ilist, const Allocator& alloc)
+	: alloc_(alloc)
+{
+	*this = ilist;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::small_swap_back_array(const small_swap_back_array& other)
+	: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+	reserve(other.size_);
+	for (const T& value : other)
+		emplace_back(value);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::small_swap_back_array(small_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	: alloc_(std::move(other.alloc_))
+{
+	steal(other);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>::~small_swap_back_array()
+{
+	clear();
+	deallocate();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>& small_swap_back_array<T, N, Allocator>::operator=(const small_swap_back_array& other)
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+	if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+	{
+		if (alloc_ != other.alloc_)
+			deallocate(); // storage must be released by the allocator that provided it
+		alloc_ = other.alloc_;
+	}
+
+	reserve(other.size_);
+	for (const T& value : other)
+		emplace_back(value);
+	return *this;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>& small_swap_back_array<T, N, Allocator>::operator=(small_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+	if constexpr (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+	{
+		deallocate();
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+			alloc_ = std::move(other.alloc_);
+		steal(other);
+	}
+	else if (alloc_ == other.alloc_)
+	{
+		deallocate();
+		steal(other);
+	}
+	else
+	{
+		// heap storage cannot change hands, move the elements one by one
+		reserve(other.size_);
+		for (T& value : other)
+			emplace_back(std::move(value));
+		other.clear();
+	}
+	return *this;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline small_swap_back_array<T, N, Allocator>& small_swap_back_array<T, N, Allocator>::operator=(std::initializer_list<T> ilist)
+{
+	clear();
+	reserve(ilist.size());
+	for (const T& value : ilist)
+		emplace_back(value);
+	return *this;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline T& small_swap_back_array<T, N, Allocator>::at(size_type index)
+{
+	if (index >= size_)
+		throw std::out_of_range("small_swap_back_array::at: index out of range");
+	return data_[index];
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline const T& small_swap_back_array<T, N, Allocator>::at(size_type index) const
+{
+	if (index >= size_)
+		throw std::out_of_range("small_swap_back_array::at: index out of range");
+	return data_[index];
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::reserve(size_type new_capacity)
+{
+	if (new_capacity > capacity_)
+		reallocate(new_capacity);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::shrink_to_fit()
+{
+	if (!is_inline() && size_ < capacity_)
+		reallocate(size_);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::clear() noexcept
+{
+	destroy_back(size_);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<typename... Args>
+inline T& small_swap_back_array<T, N, Allocator>::emplace_back(Args&&... args)
+{
+	if (size_ < capacity_)
+	{
+		alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+		return data_[size_++];
+	}
+
+	auto new_capacity = 2 * capacity_;
+	if constexpr (reallocating_allocator<Allocator> && is_trivially_relocatable_v<T>)
+	{
+		if (!is_inline())
+		{
+			// args may refer to an existing element, which reallocation can move
+			T value(std::forward<Args>(args)...);
+			reallocate(new_capacity);
+			alloc_traits::construct(alloc_, data_ + size_, std::move(value));
+			return data_[size_++];
+		}
+	}
+
+	// construct the new element first, args may refer to an existing element
+	T* new_data = alloc_traits::allocate(alloc_, new_capacity);
+	try
+	{
+		alloc_traits::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		alloc_traits::deallocate(alloc_, new_data, new_capacity);
+		throw;
+	}
+
+	try
+	{
+		relocate_to(new_data);
+	}
+	catch (...)
+	{
+		alloc_traits::destroy(alloc_, new_data + size_);
+		alloc_traits::deallocate(alloc_, new_data, new_capacity);
+		throw;
+	}
+
+	auto new_size = size_ + 1;
+	size_ = 0; // relocated
+	deallocate();
+	data_ = new_data;
+	size_ = new_size;
+	capacity_ = new_capacity;
+	return data_[size_ - 1];
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::pop_back() noexcept
+{
+	assert(size_ > 0);
+
+	destroy_back(1);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::resize(size_type count)
+{
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	reserve(count);
+	while (size_ < count)
+		emplace_back();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::resize(size_type count, const T& value)
+{
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	reserve(count);
+	while (size_ < count)
+		emplace_back(value);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(element_index < size_);
+
+	if (element_index + 1 != size_)
+	{
+		// move element if its not already the last
+		data_[element_index] = std::move(back());
+	}
+	pop_back();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(start_index + count <= size_);
+
+	erase_swap(begin() + start_index, begin() + start_index + count);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<std::same_as<typename small_swap_back_array<T, N, Allocator>::iterator> It>
+inline small_swap_back_array<T, N, Allocator>::iterator small_swap_back_array<T, N, Allocator>::erase_swap(It it) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(begin() <= it && it < end());
+
+	if (it + 1 != end())
+	{
+		// move element if its not already the last
+		*it = std::move(back());
+		pop_back();
+		return it;
+	}
+
+	pop_back();
+	return end();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<std::same_as<typename small_swap_back_array<T, N, Allocator>::iterator> It>
+inline small_swap_back_array<T, N, Allocator>::iterator small_swap_back_array<T, N, Allocator>::erase_swap(It first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(begin() <= first && first <= last && last <= end());
+
+	if (first == last)
+		return first; // no-op
+
+	auto count = static_cast<size_type>(last - first);
+	if (last == end())
+	{
+		// no need to move, range is already at the end
+		destroy_back(count);
+		return end();
+	}
+
+	// holes below the new size are filled with the same number of elements from the end
+	auto erase_it = end() - count;
+	auto moved_count = std::min<difference_type>(count, erase_it - first);
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		for (auto it = first; it != last; ++it)
+			alloc_traits::destroy(alloc_, it);
+		uninitialized_relocate(end() - moved_count, end(), first);
+		size_ -= count;
+	}
+	else
+	{
+		std::move(end() - moved_count, end(), first);
+		destroy_back(count);
+	}
+	return first;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<std::predicate<T&> Pred>
+inline small_swap_back_array<T, N, Allocator>::size_type small_swap_back_array<T, N, Allocator>::erase_swap_if(Pred pred)
+{
+	return erase_swap_if(begin(), end(), std::move(pred));
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<std::predicate<T&> Pred>
+inline small_swap_back_array<T, N, Allocator>::size_type small_swap_back_array<T, N, Allocator>::erase_swap_if(iterator first, const_iterator last, Pred pred)
+{
+	assert(begin() <= first && first <= last && last <= end());
+
+	T* items = data();
+	auto last_index = static_cast<size_type>(last - begin());
+	auto new_last = swap_partition(static_cast<size_type>(first - begin()), last_index,
+		[&](size_type i) { return static_cast<bool>(pred(items[i])); },
+		[&](size_type to, size_type from) { items[to] = std::move(items[from]); });
+
+	erase_swap(begin() + new_last, last);
+	return last_index - new_last;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::destroy_back(size_type count) noexcept
+{
+	assert(count <= size_);
+
+	for (; count > 0; --count)
+		alloc_traits::destroy(alloc_, data_ + --size_);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::reallocate(size_type new_capacity)
+{
+	assert(new_capacity >= size_);
+
+	bool to_inline = new_capacity <= N;
+	if (to_inline && is_inline())
+		return;
+
+	if (to_inline)
+		new_capacity = N;
+
+	if constexpr (reallocating_allocator<Allocator> && is_trivially_relocatable_v<T>)
+	{
+		// heap to heap, the allocator may resize the buffer without copying it
+		if (!to_inline && !is_inline())
+		{
+			data_ = alloc_.reallocate(data_, capacity_, new_capacity);
+			capacity_ = new_capacity;
+			return;
+		}
+	}
+
+	T* new_data = to_inline ? inline_data() : alloc_traits::allocate(alloc_, new_capacity);
+	try
+	{
+		relocate_to(new_data);
+	}
+	catch (...)
+	{
+		if (!to_inline)
+			alloc_traits::deallocate(alloc_, new_data, new_capacity);
+		throw;
+	}
+
+	auto size = std::exchange(size_, 0); // relocated
+	deallocate();
+	data_ = new_data;
+	size_ = size;
+	capacity_ = new_capacity;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::deallocate() noexcept
+{
+	assert(size_ == 0);
+
+	if (!is_inline())
+	{
+		alloc_traits::deallocate(alloc_, data_, capacity_);
+		data_ = inline_data();
+		capacity_ = N;
+	}
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::steal(small_swap_back_array& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+{
+	assert(size_ == 0 && is_inline());
+
+	if (other.is_inline())
+	{
+		for (T& value : other)
+			alloc_traits::construct(alloc_, data_ + size_++, std::move(value));
+		other.clear();
+		return;
+	}
+
+	data_ = std::exchange(other.data_, other.inline_data());
+	size_ = std::exchange(other.size_, 0);
+	capacity_ = std::exchange(other.capacity_, N);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+inline void small_swap_back_array<T, N, Allocator>::relocate_to(T* new_data)
+{
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		uninitialized_relocate(data_, data_ + size_, new_data);
+	}
+	else
+	{
+		size_type moved = 0;
+		try
+		{
+			for (; moved < size_; ++moved)
+				alloc_traits::construct(alloc_, new_data + moved, std::move_if_noexcept(data_[moved]));
+		}
+		catch (...)
+		{
+			while (moved > 0)
+				alloc_traits::destroy(alloc_, new_data + --moved);
+			throw;
+		}
+
+		for (size_type i = 0; i < size_; ++i)
+			alloc_traits::destroy(alloc_, data_ + i);
+	}
+}
+
+} // namespace stc
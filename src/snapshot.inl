@@ -0,0 +1,134 @@
+#pragma once
+#include "../include/stc/snapshot.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+
+namespace stc
+{
+
+// Header of a snapshot, followed by the elements.
+struct snapshot_header
+{
+	// identifies the snapshot format
+	static constexpr std::uint64_t expected_magic = 0x5354'4353'4e41'5031;
+	static constexpr std::uint32_t expected_version = 1;
+
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t element_size; // 0 for elements written through snapshot_traits
+	std::uint64_t count;
+};
+
+// Returns the number of bytes left in a seekable stream, or nothing if the stream cannot seek.
+inline std::optional<std::uint64_t> snapshot_remaining_bytes(std::istream& in)
+{
+	auto position = in.tellg();
+	if (position == std::istream::pos_type(-1))
+		return std::nullopt;
+
+	in.seekg(0, std::ios::end);
+	auto end = in.tellg();
+	in.seekg(position);
+	if (!in || end == std::istream::pos_type(-1))
+	{
+		in.clear();
+		in.seekg(position);
+		return std::nullopt;
+	}
+	return std::uint64_t(end - position);
+}
+
+template<snapshot_serializable T, typename Allocator, shrink_policy ShrinkPolicy>
+inline void write_snapshot(std::ostream& out, const swap_back_array<T, Allocator, ShrinkPolicy>& sba)
+{
+	constexpr bool bulk = std::is_trivially_copyable_v<T>;
+	snapshot_header header{snapshot_header::expected_magic, snapshot_header::expected_version, bulk ? std::uint32_t(sizeof(T)) : 0, sba.size()};
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	if constexpr (bulk)
+	{
+		// file streams hand large blocks straight to the file, bypassing their buffer
+		out.write(reinterpret_cast<const char*>(sba.data()), std::streamsize(sba.size() * sizeof(T)));
+	}
+	else
+	{
+		for (const T& value : sba)
+			snapshot_traits<T>::write(out, value);
+	}
+
+	if (!out)
+		throw std::runtime_error("write_snapshot: the stream failed");
+}
+
+template<snapshot_serializable T, typename Allocator, shrink_policy ShrinkPolicy>
+inline void read_snapshot(std::istream& in, swap_back_array<T, Allocator, ShrinkPolicy>& sba)
+{
+	constexpr bool bulk = std::is_trivially_copyable_v<T>;
+	snapshot_header header{};
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		throw std::runtime_error("read_snapshot: the stream ended before the header");
+	if (header.magic != snapshot_header::expected_magic || header.version != snapshot_header::expected_version)
+		throw std::runtime_error("read_snapshot: not a snapshot");
+	if (header.element_size != (bulk ? sizeof(T) : 0))
+		throw std::runtime_error("read_snapshot: element type mismatch");
+
+	// the count is only trusted once the stream is known to be long enough to hold the elements
+	constexpr std::size_t block_bytes = 256 * 1024;
+	constexpr std::size_t block_count = std::max<std::size_t>(1, block_bytes / sizeof(T));
+	auto remaining_bytes = snapshot_remaining_bytes(in);
+	if (bulk && remaining_bytes && header.count > *remaining_bytes / sizeof(T))
+		throw std::runtime_error("read_snapshot: the stream ended before the last element");
+
+	// an element read through snapshot_traits takes at least one byte, or the reserve is only a hint
+	sba.clear();
+	sba.reserve(std::size_t(std::min<std::uint64_t>(header.count, remaining_bytes ? *remaining_bytes / (bulk ? sizeof(T) : 1) : block_count)));
+
+	if constexpr (bulk)
+	{
+		// staged through raw storage small enough to stay in cache, then copied into the reserved storage: T may have
+		// no default constructor, and is never default constructed. Block by block, so that an unseekable stream
+		// ending early never grows the container past the data read.
+		struct alignas(T) element_bytes
+		{
+			std::byte bytes[sizeof(T)];
+		};
+		auto block = std::make_unique_for_overwrite<element_bytes[]>(std::size_t(std::min<std::uint64_t>(block_count, header.count)));
+
+		for (std::uint64_t remaining = header.count; remaining != 0;)
+		{
+			auto count = std::size_t(std::min<std::uint64_t>(block_count, remaining));
+			if (!in.read(reinterpret_cast<char*>(block.get()), std::streamsize(count * sizeof(T))))
+				throw std::runtime_error("read_snapshot: the stream ended before the last element");
+
+			// the bytes read are the object representations of trivially copyable elements
+			auto first = std::launder(reinterpret_cast<const T*>(block.get()));
+			sba.insert(sba.end(), first, first + count);
+			remaining -= count;
+		}
+	}
+	else
+	{
+		// converts to T by reading it, so that the element is initialized from the returned value, usually without a move
+		struct element_reader
+		{
+			std::istream& in;
+			operator T() const { return snapshot_traits<T>::read(in); }
+		};
+
+		for (std::uint64_t i = 0; i < header.count; ++i)
+		{
+			sba.emplace_back(element_reader{in});
+			if (!in)
+			{
+				sba.pop_back();
+				throw std::runtime_error("read_snapshot: the stream ended before the last element");
+			}
+		}
+	}
+}
+
+} // namespace stc
@@ -0,0 +1,97 @@
+#pragma once
+#include "../include/stc/sparse_set.h"
+#include <algorithm>
+#include <cassert>
+
+namespace stc
+{
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr sparse_set<Index, PageSize, Allocator>::sparse_set(const Allocator& alloc)
+	: dense_(alloc)
+	, pages_(page_allocator(alloc))
+{
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr bool sparse_set<Index, PageSize, Allocator>::insert(Index key)
+{
+	assert(key <= max_key);
+
+	auto page_index = key / PageSize;
+	if (page_index >= pages_.size())
+		pages_.resize(page_index + 1, page(dense_.get_allocator()));
+
+	// allocated on the first key, a page left empty by an exception is allocated again by the next insertion
+	auto& p = pages_[page_index];
+	if (p.empty())
+		p.assign(PageSize, absent);
+
+	auto& entry = p[key % PageSize];
+	if (entry != absent)
+		return false;
+
+	dense_.push_back(key);
+	entry = static_cast<Index>(dense_.size() - 1);
+	return true;
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr bool sparse_set<Index, PageSize, Allocator>::erase(Index key) noexcept
+{
+	auto dense_index = position(key);
+	if (dense_index == dense_.size())
+		return false;
+
+	dense_.erase_swap(dense_index);
+	if (dense_index < dense_.size())
+	{
+		// the last key was moved into the hole
+		auto moved = dense_[dense_index];
+		pages_[moved / PageSize][moved % PageSize] = static_cast<Index>(dense_index);
+	}
+
+	pages_[key / PageSize][key % PageSize] = absent;
+	return true;
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr bool sparse_set<Index, PageSize, Allocator>::contains(Index key) const noexcept
+{
+	return position(key) != dense_.size();
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr sparse_set<Index, PageSize, Allocator>::size_type sparse_set<Index, PageSize, Allocator>::position(Index key) const noexcept
+{
+	auto page_index = key / PageSize;
+	if (page_index >= pages_.size() || pages_[page_index].empty())
+		return dense_.size();
+
+	auto entry = pages_[page_index][key % PageSize];
+	return entry == absent ? dense_.size() : entry;
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr void sparse_set<Index, PageSize, Allocator>::clear() noexcept
+{
+	// only the entries in use are reset, in O(size())
+	for (auto key : dense_)
+		pages_[key / PageSize][key % PageSize] = absent;
+
+	dense_.clear();
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr void sparse_set<Index, PageSize, Allocator>::reserve(size_type new_capacity)
+{
+	dense_.reserve(new_capacity);
+}
+
+template<std::unsigned_integral Index, std::size_t PageSize, typename Allocator>
+inline constexpr sparse_set<Index, PageSize, Allocator>::size_type sparse_set<Index, PageSize, Allocator>::page_count() const noexcept
+{
+	return static_cast<size_type>(std::count_if(pages_.begin(), pages_.end(), [](const page& p) { return !p.empty(); }));
+}
+
+} // namespace stc
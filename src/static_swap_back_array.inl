@@ -0,0 +1,255 @@
+#pragma once
+#include "../include/stc/static_swap_back_array.h"
+#include <algorithm>
+
+namespace stc
+{
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>::static_swap_back_array(size_type count, const T& value)
+{
+	resize(count, value);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>::static_swap_back_array(std::initializer_list<T> ilist)
+{
+	check_capacity(ilist.size());
+
+	for (const T& value : ilist)
+		construct_back(value);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>::static_swap_back_array(const static_swap_back_array& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+{
+	for (const T& value : other)
+		construct_back(value);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>::static_swap_back_array(static_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+{
+	for (T& value : other)
+		construct_back(std::move(value));
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>& static_swap_back_array<T, Capacity>::operator=(const static_swap_back_array& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+{
+	if (this != &other)
+	{
+		clear();
+		for (const T& value : other)
+			construct_back(value);
+	}
+	return *this;
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr static_swap_back_array<T, Capacity>& static_swap_back_array<T, Capacity>::operator=(static_swap_back_array&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+{
+	if (this != &other)
+	{
+		clear();
+		for (T& value : other)
+			construct_back(std::move(value));
+	}
+	return *this;
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr T& static_swap_back_array<T, Capacity>::at(size_type index)
+{
+	if (index >= size_)
+		throw std::out_of_range("static_swap_back_array::at: index out of range");
+	return storage_.data[index];
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr const T& static_swap_back_array<T, Capacity>::at(size_type index) const
+{
+	if (index >= size_)
+		throw std::out_of_range("static_swap_back_array::at: index out of range");
+	return storage_.data[index];
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::clear() noexcept
+{
+	destroy_back(size_);
+}
+
+template<typename T, std::size_t Capacity>
+template<typename... Args>
+inline constexpr T& static_swap_back_array<T, Capacity>::emplace_back(Args&&... args)
+{
+	check_capacity(size_ + 1);
+
+	return construct_back(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t Capacity>
+template<typename... Args>
+inline constexpr T* static_swap_back_array<T, Capacity>::try_emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+{
+	if (size_ == Capacity)
+		return nullptr;
+
+	return &construct_back(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::pop_back() noexcept
+{
+	assert(size_ > 0);
+
+	destroy_back(1);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::resize(size_type count)
+{
+	check_capacity(count);
+
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	while (size_ < count)
+		construct_back();
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::resize(size_type count, const T& value)
+{
+	check_capacity(count);
+
+	if (count <= size_)
+	{
+		destroy_back(size_ - count);
+		return;
+	}
+
+	while (size_ < count)
+		construct_back(value);
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::erase_swap(size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(element_index < size_);
+
+	if (element_index + 1 != size_)
+	{
+		// move element if its not already the last
+		storage_.data[element_index] = std::move(back());
+	}
+	pop_back();
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::erase_swap(size_type start_index, size_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(start_index + count <= size_);
+
+	erase_swap(begin() + start_index, begin() + start_index + count);
+}
+
+template<typename T, std::size_t Capacity>
+template<std::same_as<typename static_swap_back_array<T, Capacity>::iterator> It>
+inline constexpr static_swap_back_array<T, Capacity>::iterator static_swap_back_array<T, Capacity>::erase_swap(It it) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(begin() <= it && it < end());
+
+	if (it + 1 != end())
+	{
+		// move element if its not already the last
+		*it = std::move(back());
+		pop_back();
+		return it;
+	}
+
+	pop_back();
+	return end();
+}
+
+template<typename T, std::size_t Capacity>
+template<std::same_as<typename static_swap_back_array<T, Capacity>::iterator> It>
+inline constexpr static_swap_back_array<T, Capacity>::iterator static_swap_back_array<T, Capacity>::erase_swap(It first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(begin() <= first && first <= last && last <= end());
+
+	if (first == last)
+		return first; // no-op
+
+	auto count = static_cast<size_type>(last - first);
+	if (last == end())
+	{
+		// no need to move, range is already at the end
+		destroy_back(count);
+		return end();
+	}
+
+	// holes below the new size are filled with the same number of elements from the end
+	auto erase_it = end() - count;
+	auto moved_count = std::min<difference_type>(count, erase_it - first);
+	std::move(end() - moved_count, end(), first);
+
+	destroy_back(count);
+	return first;
+}
+
+template<typename T, std::size_t Capacity>
+template<std::predicate<T&> Pred>
+inline constexpr static_swap_back_array<T, Capacity>::size_type static_swap_back_array<T, Capacity>::erase_swap_if(Pred pred)
+{
+	return erase_swap_if(begin(), end(), std::move(pred));
+}
+
+template<typename T, std::size_t Capacity>
+template<std::predicate<T&> Pred>
+inline constexpr static_swap_back_array<T, Capacity>::size_type static_swap_back_array<T, Capacity>::erase_swap_if(iterator first, const_iterator last, Pred pred)
+{
+	assert(begin() <= first && first <= last && last <= end());
+
+	T* items = data();
+	auto last_index = static_cast<size_type>(last - begin());
+	auto new_last = swap_partition(static_cast<size_type>(first - begin()), last_index,
+		[&](size_type i) { return static_cast<bool>(pred(items[i])); },
+		[&](size_type to, size_type from) { items[to] = std::move(items[from]); });
+
+	erase_swap(begin() + new_last, last);
+	return last_index - new_last;
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::check_capacity(size_type count)
+{
+	assert(count <= Capacity && "static_swap_back_array capacity exceeded.");
+
+	// also in release builds, instead of writing past the storage. A throw stops constant evaluation at compile time.
+	if (count > Capacity)
+		throw std::length_error("static_swap_back_array: capacity exceeded");
+}
+
+template<typename T, std::size_t Capacity>
+template<typename... Args>
+inline constexpr T& static_swap_back_array<T, Capacity>::construct_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+{
+	std::construct_at(storage_.data + size_, std::forward<Args>(args)...);
+	return storage_.data[size_++];
+}
+
+template<typename T, std::size_t Capacity>
+inline constexpr void static_swap_back_array<T, Capacity>::destroy_back(size_type count) noexcept
+{
+	assert(count <= size_);
+
+	for (; count > 0; --count)
+		std::destroy_at(storage_.data + --size_);
+}
+
+} // namespace stc
@@ -1,96 +1,374 @@
 #pragma once
 #include "../include/stc/swap_back_array.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 
 namespace stc
 {
 
-template<typename T, typename Allocator>
-inline constexpr void swap_back_array<T, Allocator>::erase_swap(base::size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap(base::size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
 {
 	assert(element_index < base::size());
 
 	if (element_index + 1 != base::size())
 	{
 		// move element if its not already the last
-		base::at(element_index) = std::move(base::back());
+		(*this)[element_index] = std::move(base::back());
 	}
 	base::pop_back();
+	apply_shrink_policy();
 }
 
-template<typename T, typename Allocator>
-inline constexpr void swap_back_array<T, Allocator>::erase_swap(base::size_type start_index, base::size_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap(base::size_type start_index, base::size_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
 {
 	assert(start_index + count <= base::size());
 
-	if (count == 0)
-		return; // no-op
-
-	auto erase_index = base::size() - count;
-	if (start_index >= erase_index)
-	{
-		// no need to move, range is already at the end
-		base::erase(base::end() - count, base::end());
-		return;
-	}
-
-	auto next_erased_index = start_index;
-	auto next_moved_index = base::size() - 1;
-	do
-	{
-		base::at(next_erased_index) = std::move(base::at(next_moved_index));
-		++next_erased_index;
-		--next_moved_index;
-
-	} while (next_erased_index < erase_index && erase_index <= next_moved_index);
-
-	base::erase(base::end() - count, base::end());
+	erase_swap(base::begin() + start_index, base::begin() + start_index + count);
 }
 
-template<typename T, typename Allocator>
-inline constexpr swap_back_array<T, Allocator>::base::iterator swap_back_array<T, Allocator>::erase_swap(base::iterator it) noexcept(std::is_nothrow_move_assignable_v<T>)
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::iterator swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap(base::iterator it) noexcept(std::is_nothrow_move_assignable_v<T>)
 {
 	assert(base::begin() <= it && it < base::end());
 
+	auto index = it - base::begin();
 	if (it + 1 != base::end())
 	{
 		// move element if its not already the last
 		*it = std::move(base::back());
-		base::pop_back();
-		return it;
 	}
 
 	base::pop_back();
-	return base::end();
+	apply_shrink_policy();
+	return base::begin() + index;
 }
 
-template<typename T, typename Allocator>
-inline constexpr swap_back_array<T, Allocator>::base::iterator swap_back_array<T, Allocator>::erase_swap(base::iterator first, base::const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>)
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::iterator swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap(base::iterator first, base::const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>)
 {
 	assert(base::begin() <= first && first <= last && last <= base::end());
 
 	if (first == last)
 		return first; // no-op
 
+	auto index = first - base::begin();
 	if (last == base::end())
 	{
 		// no need to move, range is already at the end
 		base::erase(first, base::end());
-		return base::end();
 	}
+	else
+	{
+		// holes below the new size are filled with the same number of elements from the end
+		auto erase_it = base::end() - (last - first);
+		auto moved_count = std::min(last - first, erase_it - first);
+		move_to_holes(first, moved_count);
+		base::erase(erase_it, base::end());
+	}
+
+	apply_shrink_policy();
+	return base::begin() + index;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<std::predicate<T&> Pred>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_if(Pred pred)
+{
+	return erase_swap_if(base::begin(), base::end(), std::move(pred));
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<std::predicate<T&> Pred>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_if(base::iterator first, base::const_iterator last, Pred pred)
+{
+	assert(base::begin() <= first && first <= last && last <= base::end());
+
+	using size_type = typename base::size_type;
+	T* data = base::data();
+	auto last_index = static_cast<size_type>(last - base::begin());
+	auto new_last = swap_partition(static_cast<size_type>(first - base::begin()), last_index,
+		[&](size_type i) { return static_cast<bool>(pred(data[i])); },
+		[&](size_type to, size_type from) { data[to] = std::move(data[from]); });
+
+	erase_swap(base::begin() + new_last, last);
+	return last_index - new_last;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::iterator swap_back_array<T, Allocator, ShrinkPolicy>::find_swap(const T& value) requires std::equality_comparable<T>
+{
+	return base::begin() + find_index(base::data(), base::size(), value);
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::const_iterator swap_back_array<T, Allocator, ShrinkPolicy>::find_swap(const T& value) const requires std::equality_comparable<T>
+{
+	return base::begin() + find_index(base::data(), base::size(), value);
+}
 
-	auto next_erased_it = first;
-	auto next_moved_it = base::end() - 1;
-	auto erase_it = base::end() - last + first;
-	do
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr bool swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_value(const T& value) requires std::equality_comparable<T>
+{
+	auto index = find_index(base::data(), base::size(), value);
+	if (index == base::size())
+		return false;
+
+	erase_swap(index);
+	return true;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_all(const T& value) requires std::equality_comparable<T>
+{
+	// same pairing of holes and survivors as erase_swap_if
+	auto* data = base::data();
+	auto size = base::size();
+	typename base::size_type next_tested_index = 0;
+	auto next_moved_index = size;
+	while (true)
 	{
-		*next_erased_it = std::move(*next_moved_it);
-		++next_erased_it;
-		--next_moved_it;
+		next_tested_index += find_index(data + next_tested_index, next_moved_index - next_tested_index, value);
+		if (next_tested_index == next_moved_index)
+			break;
+
+		do
+			--next_moved_index;
+		while (next_moved_index != next_tested_index && data[next_moved_index] == value);
+
+		if (next_moved_index == next_tested_index)
+			break;
+
+		data[next_tested_index] = std::move(data[next_moved_index]);
+		++next_tested_index;
+	}
+
+	auto removed = size - next_tested_index;
+	erase_swap(base::begin() + next_tested_index, base::end());
+	return removed;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_indices(std::span<const typename base::size_type> indices)
+{
+	auto removed = fill_index_holes(base::data(), base::size(), indices, [](typename base::size_type, typename base::size_type) {});
+	base::erase(base::end() - removed, base::end());
+	apply_shrink_policy();
+	return removed;
+}
 
-	} while (next_erased_it < erase_it && erase_it <= next_moved_it);
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr std::optional<relocation> swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_tracked(base::size_type element_index) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	assert(element_index < base::size());
+
+	auto last_index = base::size() - 1;
+	erase_swap(element_index);
+	if (element_index == last_index)
+		return std::nullopt;
+
+	return relocation{last_index, element_index};
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<std::output_iterator<relocation> Out>
+inline constexpr Out swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_tracked(base::size_type start_index, base::size_type count, Out out)
+{
+	assert(start_index + count <= base::size());
+
+	// same permutation as erase_swap(first, last): the holes receive the tail in order
+	auto new_size = base::size() - count;
+	auto moved_count = new_size > start_index ? std::min(count, new_size - start_index) : 0;
+	auto moved_from = base::size() - moved_count;
+	erase_swap(start_index, count);
+
+	for (typename base::size_type i = 0; i < moved_count; ++i)
+		*out++ = relocation{moved_from + i, start_index + i};
+	return out;
+}
 
-	base::erase(erase_it, base::end());
-	return first;
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<std::output_iterator<relocation> Out>
+inline constexpr Out swap_back_array<T, Allocator, ShrinkPolicy>::erase_swap_indices_tracked(std::span<const typename base::size_type> indices, Out out)
+{
+	auto removed = fill_index_holes(base::data(), base::size(), indices, [&out](typename base::size_type from, typename base::size_type to)
+	{
+		*out++ = relocation{from, to};
+	});
+	base::erase(base::end() - removed, base::end());
+	apply_shrink_policy();
+	return out;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename OnMove>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::fill_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move)
+{
+	if (indices.empty())
+		return 0; // no-op
+
+	// sorting costs O(k log k), marking costs O(k + size / 64)
+	if (indices.size() * indices_bitmap_divisor >= size)
+		return fill_marked_index_holes(data, size, indices, std::move(on_move));
+
+	return fill_sorted_index_holes(data, size, indices, std::move(on_move));
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename OnMove>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::fill_sorted_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move)
+{
+	std::vector<typename base::size_type> sorted(indices.begin(), indices.end());
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+	assert(sorted.back() < size);
+
+	auto removed = sorted.size();
+	auto new_size = size - removed;
+
+	// holes are the removed indices below new_size, each one is filled by a survivor at or above new_size
+	auto holes_end = std::lower_bound(sorted.begin(), sorted.end(), new_size);
+	auto next_skipped_it = sorted.end();
+	auto next_moved_index = size;
+	for (auto hole_it = sorted.begin(); hole_it != holes_end; ++hole_it)
+	{
+		--next_moved_index;
+		while (next_skipped_it != holes_end && *(next_skipped_it - 1) == next_moved_index)
+		{
+			// also removed, not a survivor
+			--next_skipped_it;
+			--next_moved_index;
+		}
+
+		data[*hole_it] = std::move(data[next_moved_index]);
+		on_move(next_moved_index, *hole_it);
+	}
+
+	return removed;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename OnMove>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::fill_marked_index_holes(T* data, base::size_type size, std::span<const typename base::size_type> indices, OnMove on_move)
+{
+	constexpr typename base::size_type word_bits = 64;
+	std::vector<std::uint64_t> marks((size + word_bits - 1) / word_bits);
+
+	typename base::size_type removed = 0;
+	for (auto index : indices)
+	{
+		assert(index < size);
+
+		auto& word = marks[index / word_bits];
+		auto bit = std::uint64_t(1) << (index % word_bits);
+		removed += (word & bit) == 0;
+		word |= bit;
+	}
+
+	auto new_size = size - removed;
+
+	// count the holes, i.e. the marked indices below new_size
+	typename base::size_type holes = 0;
+	for (typename base::size_type w = 0; w < new_size / word_bits; ++w)
+		holes += std::popcount(marks[w]);
+	if (new_size % word_bits != 0)
+		holes += std::popcount(marks[new_size / word_bits] & ~(~std::uint64_t(0) << (new_size % word_bits)));
+
+	fill_marked_holes(data, marks.data(), 0, size - 1, holes, std::move(on_move));
+	return removed;
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+template<typename OnMove>
+inline constexpr void swap_back_array<T, Allocator, ShrinkPolicy>::fill_marked_holes(T* data, const std::uint64_t* marks, base::size_type next_hole_index, base::size_type next_moved_index, base::size_type count, OnMove on_move)
+{
+	constexpr typename base::size_type word_bits = 64;
+
+	// fill holes in ascending order with unmarked survivors in descending order
+	for (; count > 0; --count)
+	{
+		auto w = next_hole_index / word_bits;
+		auto bits = marks[w] & (~std::uint64_t(0) << (next_hole_index % word_bits));
+		while (bits == 0)
+			bits = marks[++w];
+		auto hole_index = w * word_bits + std::countr_zero(bits);
+
+		w = next_moved_index / word_bits;
+		bits = ~marks[w] & (~std::uint64_t(0) >> (word_bits - 1 - next_moved_index % word_bits));
+		while (bits == 0)
+			bits = ~marks[--w];
+		auto moved_index = w * word_bits + (word_bits - 1 - std::countl_zero(bits));
+
+		data[hole_index] = std::move(data[moved_index]);
+		on_move(moved_index, hole_index);
+		next_hole_index = hole_index + 1;
+		next_moved_index = moved_index - 1;
+	}
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void swap_back_array<T, Allocator, ShrinkPolicy>::move_to_holes(base::iterator holes, base::difference_type count) noexcept(std::is_nothrow_move_assignable_v<T>)
+{
+	auto source = base::end() - count;
+	if (!std::is_constant_evaluated())
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			std::memcpy(std::to_address(holes), std::to_address(source), count * sizeof(T));
+			return;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			// the removed elements end up at the back, where erase destroys them
+			swap_relocate(std::to_address(holes), std::to_address(source), count);
+			return;
+		}
+	}
+
+	std::move(source, base::end(), holes);
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr swap_back_array<T, Allocator, ShrinkPolicy>::base::size_type swap_back_array<T, Allocator, ShrinkPolicy>::find_index(const T* data, base::size_type count, const T& value)
+{
+	if constexpr (simd_searchable<T>)
+	{
+		if (!std::is_constant_evaluated())
+			return simd_search::find(data, count, value);
+	}
+
+	return static_cast<base::size_type>(std::find(data, data + count, value) - data);
+}
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy>
+inline constexpr void swap_back_array<T, Allocator, ShrinkPolicy>::apply_shrink_policy() noexcept
+{
+	// a throwing move of a move-only element would lose the elements already moved, the capacity is kept instead
+	if constexpr (!std::is_nothrow_move_constructible_v<T> && !std::is_copy_constructible_v<T>)
+		return;
+
+	auto new_capacity = static_cast<typename base::size_type>(ShrinkPolicy::shrunk_capacity(base::size(), base::capacity()));
+	if (new_capacity >= base::capacity())
+		return;
+
+	assert(new_capacity >= base::size());
+
+	// best effort: removal does not throw, the capacity is kept if the reallocation fails
+	try
+	{
+		base shrunk(base::get_allocator());
+		shrunk.reserve(new_capacity);
+		if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+			shrunk.insert(shrunk.end(), std::make_move_iterator(base::begin()), std::make_move_iterator(base::end()));
+		else
+			shrunk.insert(shrunk.end(), base::begin(), base::end());
+		base::swap(shrunk);
+	}
+	catch (...)
+	{
+	}
 }
 
 } // namespace stc
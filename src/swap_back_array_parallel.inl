@@ -0,0 +1,196 @@
+#pragma once
+#include "../include/stc/swap_back_array_parallel.h"
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <latch>
+#include <vector>
+
+namespace stc
+{
+
+template<typename T, typename Allocator, shrink_policy ShrinkPolicy, std::predicate<T&> Pred>
+inline std::size_t erase_swap_if_parallel(swap_back_array<T, Allocator, ShrinkPolicy>& array, Pred pred, unsigned thread_count)
+{
+	using size_type = std::size_t;
+	constexpr size_type word_bits = 64;
+	// each thread gets at least this many elements
+	constexpr size_type min_chunk_size = 1 << 16;
+
+	auto size = array.size();
+	thread_count = static_cast<unsigned>(std::min<size_type>(thread_count, size / min_chunk_size));
+	if (thread_count <= 1)
+		return array.erase_swap_if(std::move(pred));
+
+	T* data = array.data();
+	auto word_count = (size + word_bits - 1) / word_bits;
+	std::vector<std::uint64_t> marks(word_count);
+
+	// chunks are made of whole words, so that no word is written by two threads
+	auto chunk_first_word = [&](size_type chunk) { return word_count * chunk / thread_count; };
+	auto mask_below = [](size_type word, size_type limit) -> std::uint64_t
+	{
+		// bits of the word whose index is below limit
+		if (limit >= (word + 1) * word_bits)
+			return ~std::uint64_t(0);
+		if (limit <= word * word_bits)
+			return 0;
+		return (std::uint64_t(1) << (limit - word * word_bits)) - 1;
+	};
+
+	// per chunk counts, then prefix sums: holes in ascending chunk order, survivors in descending chunk order
+	std::vector<size_type> removed(thread_count), holes(thread_count), survivors(thread_count);
+	std::vector<size_type> holes_before(thread_count), survivors_after(thread_count);
+	size_type new_size = 0;
+	size_type move_count = 0;
+
+	auto count_removed = [&]() noexcept
+	{
+		size_type total = 0;
+		for (auto count : removed)
+			total += count;
+		new_size = size - total;
+	};
+
+	auto sum_moves = [&]() noexcept
+	{
+		for (size_type c = 0; c < thread_count; ++c)
+		{
+			holes_before[c] = move_count;
+			move_count += holes[c];
+		}
+		size_type after = 0;
+		for (size_type c = thread_count; c-- > 0;)
+		{
+			survivors_after[c] = after;
+			after += survivors[c];
+		}
+		assert(after == move_count);
+	};
+
+	// index of the rank-th hole, in ascending order
+	auto select_hole = [&](size_type rank)
+	{
+		size_type c = 0;
+		while (holes_before[c] + holes[c] <= rank)
+			++c;
+		rank -= holes_before[c];
+		for (auto w = chunk_first_word(c);; ++w)
+		{
+			auto bits = marks[w] & mask_below(w, new_size);
+			auto count = static_cast<size_type>(std::popcount(bits));
+			if (rank < count)
+			{
+				for (; rank > 0; --rank)
+					bits &= bits - 1;
+				return w * word_bits + std::countr_zero(bits);
+			}
+			rank -= count;
+		}
+	};
+
+	// index of the rank-th survivor above new_size, in descending order
+	auto select_survivor = [&](size_type rank)
+	{
+		size_type c = thread_count - 1;
+		while (survivors_after[c] + survivors[c] <= rank)
+			--c;
+		rank -= survivors_after[c];
+		for (auto w = chunk_first_word(c + 1) - 1;; --w)
+		{
+			auto bits = ~marks[w] & ~mask_below(w, new_size) & mask_below(w, size);
+			auto count = static_cast<size_type>(std::popcount(bits));
+			if (rank < count)
+			{
+				for (; rank > 0; --rank)
+					bits &= ~(std::uint64_t(1) << (word_bits - 1 - std::countl_zero(bits)));
+				return w * word_bits + (word_bits - 1 - std::countl_zero(bits));
+			}
+			rank -= count;
+		}
+	};
+
+	std::barrier mark_done(thread_count, count_removed);
+	std::barrier count_done(thread_count, sum_moves);
+
+	// an exception would leave the other threads waiting at a barrier: every thread terminates instead
+	auto process_chunk = [&](size_type chunk) noexcept
+	{
+		auto first_word = chunk_first_word(chunk);
+		auto last_word = chunk_first_word(chunk + 1);
+		auto last = std::min(last_word * word_bits, size);
+
+		// test each element once, building each word in a register
+		size_type chunk_removed = 0;
+		for (auto w = first_word; w < last_word; ++w)
+		{
+			std::uint64_t bits = 0;
+			auto word_first = w * word_bits;
+			auto word_size = std::min(word_bits, last - word_first);
+			for (size_type b = 0; b < word_size; ++b)
+				bits |= std::uint64_t(static_cast<bool>(pred(data[word_first + b]))) << b;
+			marks[w] = bits;
+			chunk_removed += std::popcount(bits);
+		}
+		removed[chunk] = chunk_removed;
+		mark_done.arrive_and_wait();
+
+		// holes are the marked elements below new_size, survivors the unmarked ones above it
+		size_type chunk_holes = 0, chunk_survivors = 0;
+		for (auto w = first_word; w < last_word; ++w)
+		{
+			chunk_holes += std::popcount(marks[w] & mask_below(w, new_size));
+			chunk_survivors += std::popcount(~marks[w] & ~mask_below(w, new_size) & mask_below(w, size));
+		}
+		holes[chunk] = chunk_holes;
+		survivors[chunk] = chunk_survivors;
+		count_done.arrive_and_wait();
+
+		// each thread fills an even share of the holes, with the survivors of the same ranks
+		auto first_move = move_count * chunk / thread_count;
+		auto last_move = move_count * (chunk + 1) / thread_count;
+		if (first_move != last_move)
+			swap_back_array<T, Allocator, ShrinkPolicy>::fill_marked_holes(data, marks.data(), select_hole(first_move), select_survivor(first_move), last_move - first_move, [](size_type, size_type) {});
+	};
+
+	// workers wait until all of them are created, so that a failed creation never leaves the others at a barrier
+	bool creation_failed = false;
+	{
+		std::latch created(1);
+		std::vector<std::jthread> threads;
+		try
+		{
+			threads.reserve(thread_count - 1);
+			for (size_type chunk = 1; chunk < thread_count; ++chunk)
+			{
+				threads.emplace_back([&, chunk]()
+				{
+					created.wait();
+					if (!creation_failed)
+						process_chunk(chunk);
+				});
+			}
+		}
+		catch (...)
+		{
+			creation_failed = true;
+		}
+		created.count_down();
+
+		if (!creation_failed)
+			process_chunk(0);
+	}
+
+	// nothing was tested nor moved yet
+	if (creation_failed)
+		return array.erase_swap_if(std::move(pred));
+
+	auto removed_count = size - new_size;
+	// the tail only holds removed and moved-from elements, nothing is moved
+	array.erase_swap(array.begin() + new_size, array.end());
+	return removed_count;
+}
+
+} // namespace stc
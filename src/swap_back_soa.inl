@@ -0,0 +1,106 @@
+#pragma once
+#include "../include/stc/swap_back_soa.h"
+
+namespace stc
+{
+
+template<typename... Ts>
+template<typename... Args>
+	requires (sizeof...(Args) == sizeof...(Ts))
+inline constexpr void swap_back_soa<Ts...>::emplace_back(Args&&... args)
+{
+	auto forwarded = std::forward_as_tuple(std::forward<Args>(args)...);
+	size_type pushed = 0;
+	try
+	{
+		[&]<size_type... I>(std::index_sequence<I...>)
+		{
+			((std::get<I>(columns_).emplace_back(std::get<I>(std::move(forwarded))), ++pushed), ...);
+		}(std::index_sequence_for<Ts...>{});
+	}
+	catch (...)
+	{
+		// keep the columns in sync
+		[&]<size_type... I>(std::index_sequence<I...>)
+		{
+			((I < pushed ? std::get<I>(columns_).pop_back() : void()), ...);
+		}(std::index_sequence_for<Ts...>{});
+		throw;
+	}
+}
+
+template<typename... Ts>
+inline constexpr void swap_back_soa<Ts...>::erase_swap(size_type row_index) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...))
+{
+	assert(row_index < size());
+
+	std::apply([&](auto&... columns) { (columns.erase_swap(row_index), ...); }, columns_);
+}
+
+template<typename... Ts>
+inline constexpr void swap_back_soa<Ts...>::erase_swap(size_type start_index, size_type count) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...))
+{
+	assert(start_index + count <= size());
+
+	// every column performs the same moves, so they stay in sync
+	std::apply([&](auto&... columns) { (columns.erase_swap(start_index, count), ...); }, columns_);
+}
+
+template<typename... Ts>
+template<std::predicate<Ts&...> Pred>
+inline constexpr swap_back_soa<Ts...>::size_type swap_back_soa<Ts...>::erase_swap_if(Pred pred)
+{
+	return erase_swap_if(0, size(), std::move(pred));
+}
+
+template<typename... Ts>
+template<std::predicate<Ts&...> Pred>
+inline constexpr swap_back_soa<Ts...>::size_type swap_back_soa<Ts...>::erase_swap_if(size_type start_index, size_type count, Pred pred)
+{
+	assert(start_index + count <= size());
+
+	auto end_index = start_index + count;
+	auto new_end = swap_partition(start_index, end_index,
+		[&](size_type i) { return static_cast<bool>(std::apply(pred, row(i))); },
+		[&](size_type to, size_type from) { move_row(to, from); });
+
+	auto removed = end_index - new_end;
+	erase_swap(new_end, removed);
+	return removed;
+}
+
+template<typename... Ts>
+inline constexpr std::tuple<Ts&...> swap_back_soa<Ts...>::row(size_type row_index) noexcept
+{
+	assert(row_index < size());
+
+	return std::apply([&](auto&... columns) { return std::tuple<Ts&...>(columns[row_index]...); }, columns_);
+}
+
+template<typename... Ts>
+inline constexpr std::tuple<const Ts&...> swap_back_soa<Ts...>::row(size_type row_index) const noexcept
+{
+	assert(row_index < size());
+
+	return std::apply([&](const auto&... columns) { return std::tuple<const Ts&...>(columns[row_index]...); }, columns_);
+}
+
+template<typename... Ts>
+inline constexpr void swap_back_soa<Ts...>::reserve(size_type new_capacity)
+{
+	std::apply([&](auto&... columns) { (columns.reserve(new_capacity), ...); }, columns_);
+}
+
+template<typename... Ts>
+inline constexpr void swap_back_soa<Ts...>::clear() noexcept
+{
+	std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+}
+
+template<typename... Ts>
+inline constexpr void swap_back_soa<Ts...>::move_row(size_type dst, size_type src) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...))
+{
+	std::apply([&](auto&... columns) { ((columns[dst] = std::move(columns[src])), ...); }, columns_);
+}
+
+} // namespace stc
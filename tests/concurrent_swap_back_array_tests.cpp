@@ -0,0 +1,119 @@
+#include "stc/concurrent_swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+
+// Appends require a non-throwing constructor.
+struct nothrow_element : test_element
+{
+	nothrow_element(size_t id, test_element_data& data) noexcept : test_element(id, data) {}
+};
+
+} // namespace
+
+TEST(concurrent_swap_back_array, append_until_full)
+{
+	constexpr size_t thread_count = 8;
+	constexpr size_t per_thread = 1000;
+	stc::concurrent_swap_back_array<size_t> values(thread_count * per_thread - 10);
+
+	std::vector<std::thread> threads;
+	std::atomic<size_t> rejected = 0;
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]
+		{
+			for (size_t i = 0; i < per_thread; ++i)
+			{
+				if (!values.try_push_back(t * per_thread + i))
+					++rejected;
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	// every slot is claimed once, the overflow is rejected
+	EXPECT_TRUE(values.full());
+	EXPECT_EQ(rejected, 10);
+
+	std::vector<size_t> sorted(values.begin(), values.end());
+	std::sort(sorted.begin(), sorted.end());
+	EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+}
+
+TEST(concurrent_swap_back_array, deferred_erase)
+{
+	constexpr size_t thread_count = 4;
+	stc::concurrent_swap_back_array<size_t> values(1000);
+	for (size_t i = 0; i < 1000; ++i)
+		values.try_push_back(i);
+
+	// each thread queues the multiples of 3 in its quarter, plus a duplicate
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]
+		{
+			for (size_t i = t * 250; i < (t + 1) * 250; ++i)
+			{
+				if (i % 3 == 0)
+					values.erase_swap(i);
+			}
+			values.erase_swap(0);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	EXPECT_EQ(values.size(), 1000);
+	EXPECT_EQ(values.pending_erase_count(), 334 + thread_count);
+
+	std::vector<size_t> index_of(1000);
+	for (size_t i = 0; i < values.size(); ++i)
+		index_of[values[i]] = i;
+
+	std::vector<stc::relocation> moves;
+	values.flush_tracked(std::back_inserter(moves));
+	EXPECT_EQ(values.size(), 666);
+	EXPECT_EQ(values.pending_erase_count(), 0);
+	for (auto [from, to] : moves)
+		index_of[values[to]] = to;
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		EXPECT_NE(values[i] % 3, 0);
+		EXPECT_EQ(index_of[values[i]], i);
+	}
+
+	EXPECT_EQ(values.flush(), 0);
+}
+
+TEST(concurrent_swap_back_array, element_lifetime)
+{
+	test_element_data data;
+	{
+		stc::concurrent_swap_back_array<nothrow_element> elements(4);
+		for (size_t i = 0; i < 4; ++i)
+			elements.try_emplace_back(i, data);
+		EXPECT_EQ(elements.try_emplace_back(4, data), nullptr);
+
+		elements.erase_swap(1);
+		elements.erase_swap(3);
+		EXPECT_EQ(elements.flush(), 2);
+		EXPECT_EQ(data.dtor_counter, 2);
+		EXPECT_EQ(data.move_counter, 1);
+
+		elements.reserve(8);
+		EXPECT_EQ(elements.capacity(), 8);
+		EXPECT_EQ(elements.size(), 2);
+		EXPECT_EQ(elements[1].id, 2);
+		EXPECT_NE(elements.try_emplace_back(5, data), nullptr);
+	}
+	EXPECT_EQ(data.ctor_counter, 5);
+	EXPECT_EQ(data.dtor_counter, 2 + 2 + 3);
+}
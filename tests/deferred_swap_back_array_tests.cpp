@@ -0,0 +1,126 @@
+#include "stc/deferred_swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+using test_deferred = stc::deferred_swap_back_array<test_element>;
+
+std::vector<size_t> live_ids(const test_deferred& dsba)
+{
+	std::vector<size_t> ids;
+	for (const test_element& te : dsba)
+		ids.push_back(te.id);
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+} // namespace
+
+static_assert(std::forward_iterator<stc::deferred_swap_back_array<int>::iterator>);
+static_assert(std::forward_iterator<stc::deferred_swap_back_array<int>::const_iterator>);
+
+TEST(deferred_swap_back_array, erase_while_iterating)
+{
+	test_element_data data;
+	test_deferred dsba;
+	dsba.reserve(200);
+	for (size_t i = 0; i < 200; ++i)
+		dsba.emplace_back(i, data);
+	test_element* first = &dsba[0];
+
+	// nested loops erase elements of the loop they are in, and of the enclosing one
+	size_t visited = 0;
+	for (auto it = dsba.begin(); it != dsba.end(); ++it)
+	{
+		++visited;
+		if (it->id % 10 != 0)
+			continue;
+		for (auto& other : dsba)
+		{
+			if (other.id == it->id + 1 || other.id == it->id + 2)
+			{
+				EXPECT_TRUE(dsba.erase_deferred(&other - first));
+			}
+		}
+		EXPECT_TRUE(dsba.erase_deferred(it));
+		EXPECT_FALSE(dsba.erase_deferred(it));
+	}
+
+	// elements erased ahead of the outer loop were skipped, nothing moved
+	EXPECT_EQ(visited, 160);
+	EXPECT_EQ(&dsba[3], first + 3);
+	EXPECT_EQ(dsba.size(), 140);
+	EXPECT_EQ(dsba.slot_count(), 200);
+	EXPECT_EQ(dsba.erased_count(), 60);
+	EXPECT_TRUE(dsba.is_erased(0));
+	EXPECT_FALSE(dsba.is_erased(3));
+	EXPECT_EQ(data.dtor_counter, 0);
+
+	std::vector<size_t> expected;
+	for (size_t i = 0; i < 200; ++i)
+		if (i % 10 > 2)
+			expected.push_back(i);
+	EXPECT_EQ(live_ids(dsba), expected);
+}
+
+TEST(deferred_swap_back_array, compact)
+{
+	test_element_data data;
+	{
+		test_deferred dsba;
+		dsba.reserve(301);
+		for (size_t i = 0; i < 300; ++i)
+			dsba.emplace_back(i, data);
+
+		// whole erased words, and erased slots on both sides of the new size
+		for (size_t i = 0; i < 300; ++i)
+			if ((i >= 64 && i < 192) || i % 7 == 0)
+				dsba.erase_deferred(i);
+		auto expected = live_ids(dsba);
+
+		EXPECT_EQ(dsba.compact(), 300 - expected.size());
+		EXPECT_EQ(dsba.slot_count(), expected.size());
+		EXPECT_EQ(dsba.erased_count(), 0);
+		EXPECT_EQ(live_ids(dsba), expected);
+		for (size_t i = 0; i < dsba.slot_count(); ++i)
+			EXPECT_FALSE(dsba.is_erased(i));
+		EXPECT_EQ(data.copy_counter, 0);
+		EXPECT_EQ(data.dtor_counter, 300 - expected.size());
+
+		// slots appended after a compaction are live
+		dsba.emplace_back(1000, data);
+		EXPECT_FALSE(dsba.is_erased(dsba.slot_count() - 1));
+		EXPECT_EQ(dsba.compact(), 0);
+
+		// everything erased
+		for (size_t i = 0; i < dsba.slot_count(); ++i)
+			dsba.erase_deferred(i);
+		EXPECT_EQ(dsba.begin(), dsba.end());
+		dsba.compact();
+		EXPECT_TRUE(dsba.empty());
+		EXPECT_EQ(dsba.slot_count(), 0);
+	}
+	EXPECT_EQ(data.ctor_counter, 301);
+	EXPECT_EQ(data.dtor_counter, 301);
+}
+
+TEST(deferred_swap_back_array, compact_tracked)
+{
+	stc::deferred_swap_back_array<int> dsba;
+	for (int i = 0; i < 10; ++i)
+		dsba.push_back(i);
+	dsba.erase_deferred(1);
+	dsba.erase_deferred(4);
+	dsba.erase_deferred(8);
+
+	std::vector<stc::relocation> moves;
+	dsba.compact_tracked(std::back_inserter(moves));
+	EXPECT_EQ(moves, (std::vector<stc::relocation>{{9, 1}, {7, 4}}));
+	ASSERT_EQ(dsba.slot_count(), 7);
+	EXPECT_EQ(dsba[1], 9);
+	EXPECT_EQ(dsba[4], 7);
+}
@@ -0,0 +1,151 @@
+#include "stc/huge_page_allocator.h"
+#include "stc/small_swap_back_array.h"
+#include "stc/swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+
+TEST(huge_page_allocator, allocate)
+{
+	using resource = stc::huge_page_resource;
+
+	void* small = resource::allocate(100, 64);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % 64, 0);
+	std::memset(small, 0xAB, 100);
+	resource::deallocate(small, 100, 64);
+
+	// not a multiple of the huge page size
+	constexpr std::size_t large_size = resource::huge_page_size * 3 + 123;
+	void* large = resource::allocate(large_size);
+#if defined(__linux__)
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % resource::huge_page_size, 0);
+#endif
+	auto* bytes = static_cast<unsigned char*>(large);
+	std::memset(bytes, 0xCD, large_size);
+	EXPECT_EQ(bytes[0], 0xCD);
+	EXPECT_EQ(bytes[large_size - 1], 0xCD);
+	resource::deallocate(large, large_size);
+
+	// fallback state is remembered, further allocations still succeed
+	void* again = resource::allocate(large_size);
+	EXPECT_NE(again, nullptr);
+	resource::deallocate(again, large_size);
+}
+
+TEST(huge_page_allocator, reallocate)
+{
+	using resource = stc::huge_page_resource;
+	constexpr std::size_t page = resource::huge_page_size;
+
+	auto fill = [](void* ptr, std::size_t bytes)
+	{
+		auto* values = static_cast<std::uint32_t*>(ptr);
+		for (std::size_t i = 0; i < bytes / sizeof(std::uint32_t); ++i)
+			values[i] = std::uint32_t(i);
+	};
+	auto check = [](const void* ptr, std::size_t bytes)
+	{
+		auto* values = static_cast<const std::uint32_t*>(ptr);
+		for (std::size_t i = 0; i < bytes / sizeof(std::uint32_t); ++i)
+		{
+			if (values[i] != std::uint32_t(i))
+				return false;
+		}
+		return true;
+	};
+
+	// small to large
+	void* ptr = resource::allocate(1000);
+	fill(ptr, 1000);
+	ptr = resource::reallocate(ptr, 1000, page);
+	EXPECT_TRUE(check(ptr, 1000));
+	fill(ptr, page);
+
+	// large to larger, twice to exercise both in place growth and moves
+	void* blocker = resource::allocate(page);
+	ptr = resource::reallocate(ptr, page, page * 4);
+	EXPECT_TRUE(check(ptr, page));
+#if defined(__linux__)
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % page, 0);
+#endif
+	fill(ptr, page * 4);
+	ptr = resource::reallocate(ptr, page * 4, page * 8 + 100);
+	EXPECT_TRUE(check(ptr, page * 4));
+	resource::deallocate(blocker, page);
+
+	// shrink, then back to small
+	ptr = resource::reallocate(ptr, page * 8 + 100, page * 2);
+	EXPECT_TRUE(check(ptr, page * 2));
+	ptr = resource::reallocate(ptr, page * 2, 64);
+	EXPECT_TRUE(check(ptr, 64));
+	resource::deallocate(ptr, 64);
+}
+
+TEST(huge_page_allocator, container_growth)
+{
+	static_assert(stc::reallocating_allocator<stc::huge_page_allocator<int>>);
+	static_assert(!stc::reallocating_allocator<stc::huge_page_allocator<test_element>>);
+
+	constexpr int count = int(stc::huge_page_resource::min_huge_allocation / sizeof(int)) * 5;
+	stc::small_swap_back_array<int, 16, stc::huge_page_allocator<int>> ssba;
+	for (int i = 0; i < count; ++i)
+		ssba.push_back(i);
+	for (int i = 0; i < count; ++i)
+		ASSERT_EQ(ssba[i], i);
+
+	ssba.erase_swap(0, count / 2);
+	ssba.shrink_to_fit();
+	EXPECT_EQ(ssba.capacity(), ssba.size());
+	EXPECT_EQ(ssba[0], count - count / 2);
+}
+
+TEST(huge_page_allocator, traits)
+{
+	stc::huge_page_allocator<int> a;
+	stc::huge_page_allocator<double> b(a);
+	EXPECT_TRUE(a == b);
+	static_assert(std::allocator_traits<stc::huge_page_allocator<int>>::is_always_equal::value);
+	static_assert(std::is_same_v<std::allocator_traits<stc::huge_page_allocator<int>>::rebind_alloc<char>, stc::huge_page_allocator<char>>);
+}
+
+TEST(huge_page_allocator, swap_back_array)
+{
+	// grows from the global allocator to huge pages
+	constexpr int count = int(stc::huge_page_resource::min_huge_allocation / sizeof(int)) * 2;
+	stc::swap_back_array<int, stc::huge_page_allocator<int>> sba;
+	for (int i = 0; i < count; ++i)
+		sba.push_back(i);
+	ASSERT_EQ(sba.size(), count);
+	EXPECT_EQ(sba[count - 1], count - 1);
+
+	sba.erase_swap(0);
+	EXPECT_EQ(sba[0], count - 1);
+	EXPECT_EQ(sba.size(), count - 1);
+
+	auto copy = sba;
+	EXPECT_EQ(copy[0], count - 1);
+	EXPECT_EQ(copy[count - 2], count - 2);
+
+	// and back
+	sba.resize(10);
+	sba.shrink_to_fit();
+	EXPECT_EQ(sba[9], 9);
+}
+
+TEST(huge_page_allocator, lifetime)
+{
+	constexpr std::size_t count = stc::huge_page_resource::min_huge_allocation / sizeof(test_element) + 1;
+	test_element_data data;
+	{
+		stc::swap_back_array<test_element, stc::huge_page_allocator<test_element>> sba;
+		sba.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+			sba.emplace_back(i, data);
+		sba.erase_swap(0, 10);
+		EXPECT_EQ(sba.size(), count - 10);
+		EXPECT_EQ(sba[0].id, count - 10);
+	}
+	EXPECT_EQ(data.ctor_counter, count);
+	EXPECT_EQ(data.dtor_counter, count);
+}
@@ -0,0 +1,156 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include "stc/mapped_swap_back_array.h"
+#include "stc/swap_back_array.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+struct entity
+{
+	std::uint32_t id;
+	float position[3];
+	std::uint64_t flags;
+
+	bool operator==(const entity&) const = default;
+};
+
+// A file path removed at the end of the test.
+struct temporary_file
+{
+	explicit temporary_file(const char* name)
+		: path(std::filesystem::temp_directory_path() / name)
+	{
+		std::filesystem::remove(path);
+	}
+
+	~temporary_file() { std::filesystem::remove(path); }
+
+	std::filesystem::path path;
+};
+
+} // namespace
+
+TEST(mapped_swap_back_array, reopen)
+{
+	temporary_file file("stc_mapped_reopen.bin");
+	{
+		stc::mapped_swap_back_array<entity> entities(file.path);
+		EXPECT_TRUE(entities.empty());
+		for (std::uint32_t i = 0; i < 1000; ++i)
+			entities.push_back({i, {float(i), 0.f, -float(i)}, i * 3ull});
+
+		entities.erase_swap(0);
+		EXPECT_EQ(entities[0].id, 999);
+		EXPECT_EQ(entities.size(), 999);
+		EXPECT_GE(entities.capacity(), 1000);
+	}
+	{
+		stc::mapped_swap_back_array<entity> entities(file.path);
+		ASSERT_EQ(entities.size(), 999);
+		EXPECT_TRUE(entities.verify_checksum());
+		EXPECT_EQ(entities[0], (entity{999, {999.f, 0.f, -999.f}, 2997}));
+		for (std::uint32_t i = 1; i < 999; ++i)
+			EXPECT_EQ(entities[i].id, i);
+
+		// keeps working against the mapping
+		entities.emplace_back(entity{5000, {}, 0});
+		entities.pop_back();
+		entities.erase_swap(1);
+	}
+	{
+		stc::mapped_swap_back_array<entity> entities(file.path, stc::mapped_swap_back_array<entity>::open_check::header);
+		EXPECT_EQ(entities.size(), 998);
+		EXPECT_EQ(entities[1].id, 998);
+	}
+}
+
+TEST(mapped_swap_back_array, erase_matches_swap_back_array)
+{
+	temporary_file file("stc_mapped_erase.bin");
+	stc::mapped_swap_back_array<int> mapped(file.path);
+	stc::swap_back_array<int> reference;
+	for (int i = 0; i < 200; ++i)
+	{
+		mapped.push_back(i);
+		reference.push_back(i);
+	}
+
+	mapped.erase_swap(10, 5);
+	reference.erase_swap(10, 5);
+	mapped.erase_swap(180, 15);
+	reference.erase_swap(180, 15);
+	EXPECT_EQ(mapped.erase_swap_if([](int v) { return v % 3 == 0; }), reference.erase_swap_if([](int v) { return v % 3 == 0; }));
+
+	ASSERT_EQ(mapped.size(), reference.size());
+	for (std::size_t i = 0; i < mapped.size(); ++i)
+		EXPECT_EQ(mapped[i], reference[i]);
+
+	mapped.clear();
+	EXPECT_TRUE(mapped.empty());
+}
+
+TEST(mapped_swap_back_array, growth_and_move)
+{
+	temporary_file file("stc_mapped_growth.bin");
+	stc::mapped_swap_back_array<std::uint64_t> values(file.path);
+	values.reserve(10);
+	for (std::uint64_t i = 0; i < 100'000; ++i)
+		values.push_back(i);
+
+	// the argument refers to an element when the mapping grows
+	while (values.size() != values.capacity())
+		values.push_back(0);
+	values.push_back(values[42]);
+	EXPECT_EQ(values.back(), 42);
+
+	auto moved = std::move(values);
+	EXPECT_EQ(moved[99'999], 99'999);
+	moved.sync();
+	EXPECT_TRUE(moved.verify_checksum());
+	moved.push_back(1);
+	EXPECT_FALSE(moved.verify_checksum());
+}
+
+TEST(mapped_swap_back_array, rejects_invalid_files)
+{
+	temporary_file file("stc_mapped_invalid.bin");
+	{
+		stc::mapped_swap_back_array<std::uint32_t> values(file.path);
+		for (std::uint32_t i = 0; i < 100; ++i)
+			values.push_back(i);
+	}
+
+	// other element type
+	EXPECT_THROW(stc::mapped_swap_back_array<std::uint64_t>{file.path}, std::runtime_error);
+
+	// corrupt an element
+	{
+		std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+		stream.seekp(stc::mapped_swap_back_array<std::uint32_t>::header_size + 4 * 50);
+		std::uint32_t corrupted = 12345;
+		stream.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+	}
+	EXPECT_THROW(stc::mapped_swap_back_array<std::uint32_t>{file.path}, std::runtime_error);
+
+	// the header check alone does not read the elements
+	{
+		stc::mapped_swap_back_array<std::uint32_t> values(file.path, stc::mapped_swap_back_array<std::uint32_t>::open_check::header);
+		EXPECT_FALSE(values.verify_checksum());
+		EXPECT_EQ(values[50], 12345);
+	}
+
+	// not a mapped_swap_back_array file
+	{
+		std::ofstream stream(file.path, std::ios::binary | std::ios::trunc);
+		stream << "some text file, longer than a header of sixty four bytes, for the magic check to fail";
+	}
+	EXPECT_THROW(stc::mapped_swap_back_array<std::uint32_t>{file.path}, std::runtime_error);
+}
+
+#endif
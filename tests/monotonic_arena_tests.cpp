@@ -0,0 +1,100 @@
+#include "stc/monotonic_arena.h"
+#include "stc/slot_map.h"
+#include "stc/small_swap_back_array.h"
+#include "stc/swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+TEST(monotonic_arena, allocate)
+{
+	stc::monotonic_arena arena(1024);
+
+	void* a = arena.allocate(100);
+	void* b = arena.allocate(8, 64);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0);
+	EXPECT_GE(static_cast<std::byte*>(b), static_cast<std::byte*>(a) + 100);
+	EXPECT_EQ(arena.upstream_allocations(), 1);
+
+	// the most recent allocation is rolled back, others are not
+	arena.deallocate(b, 8);
+	EXPECT_EQ(arena.allocate(8, 64), b);
+	arena.deallocate(a, 100);
+	EXPECT_NE(arena.allocate(100), a);
+
+	// larger than a block
+	void* large = arena.allocate(10'000);
+	EXPECT_NE(large, nullptr);
+	EXPECT_EQ(arena.upstream_allocations(), 2);
+}
+
+TEST(monotonic_arena, reset_keeps_largest_block)
+{
+	stc::monotonic_arena arena(256);
+	for (int i = 0; i < 100; ++i)
+		(void)arena.allocate(64);
+
+	auto blocks = arena.upstream_allocations();
+	auto capacity = arena.capacity();
+	EXPECT_GT(blocks, 1);
+
+	arena.reset();
+	EXPECT_LT(arena.capacity(), capacity);
+
+	// the second frame adds a block as large as the first frame used
+	for (int i = 0; i < 100; ++i)
+		(void)arena.allocate(64);
+	EXPECT_EQ(arena.upstream_allocations(), blocks + 1);
+
+	// then the same workload fits in the kept block
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		arena.reset();
+		for (int i = 0; i < 100; ++i)
+			(void)arena.allocate(64);
+	}
+	EXPECT_EQ(arena.upstream_allocations(), blocks + 1);
+
+	arena.release();
+	EXPECT_EQ(arena.capacity(), 0);
+}
+
+TEST(monotonic_arena, containers)
+{
+	stc::monotonic_arena arena;
+	test_element_data data;
+	{
+		stc::arena_allocator<test_element> alloc(arena);
+		stc::swap_back_array<test_element, stc::arena_allocator<test_element>> sba(alloc);
+		sba.reserve(100);
+		for (size_t i = 0; i < 100; ++i)
+			sba.emplace_back(i, data);
+		sba.erase_swap(0, 10);
+		EXPECT_EQ(sba.size(), 90);
+
+		stc::small_swap_back_array<int, 4, stc::arena_allocator<int>> ssba(arena);
+		for (int i = 0; i < 100; ++i)
+			ssba.push_back(i);
+		EXPECT_FALSE(ssba.is_inline());
+
+		// the slot map rebinds the allocator for its index arrays
+		stc::slot_map<int, stc::arena_allocator<int>> map(arena);
+		auto h = map.insert(42);
+		EXPECT_EQ(map[h], 42);
+
+		EXPECT_EQ(sba.get_allocator(), ssba.get_allocator());
+	}
+	EXPECT_EQ(data.dtor_counter, 100);
+	EXPECT_EQ(arena.upstream_allocations(), 1);
+}
+
+TEST(monotonic_arena, huge_allocation)
+{
+	stc::monotonic_arena arena;
+
+	// the block size would wrap around
+	EXPECT_THROW((void)arena.allocate(std::size_t(-1) - 8, 8), std::bad_alloc);
+	EXPECT_THROW((void)arena.allocate(std::size_t(-1) - 64, 256), std::bad_alloc);
+	EXPECT_EQ(arena.upstream_allocations(), 0);
+	EXPECT_EQ(arena.capacity(), 0);
+}
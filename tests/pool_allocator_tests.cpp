@@ -0,0 +1,79 @@
+#include "stc/pool_allocator.h"
+#include "stc/segmented_swap_back_array.h"
+#include "stc/swap_back_array.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+TEST(pool_allocator, size_classes)
+{
+	stc::pool_resource pool;
+
+	void* a = pool.allocate(100);
+	void* b = pool.allocate(8, 64);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0);
+
+	// freed memory is reused by the next allocation of the same size class
+	pool.deallocate(a, 100);
+	EXPECT_EQ(pool.allocate(128), a);
+	pool.deallocate(b, 8, 64);
+	EXPECT_NE(pool.allocate(256), b);
+	EXPECT_EQ(pool.allocate(64, 64), b);
+}
+
+TEST(pool_allocator, reuse_across_containers)
+{
+	stc::pool_resource pool;
+	stc::pool_allocator<int> alloc(pool);
+
+	auto fill = [&]
+	{
+		stc::swap_back_array<int, stc::pool_allocator<int>> sba(alloc);
+		for (int i = 0; i < 1000; ++i)
+			sba.push_back(i);
+		sba.erase_swap_if([](int value) { return value % 2 == 0; });
+		EXPECT_EQ(sba.size(), 500);
+	};
+
+	fill();
+	auto blocks = pool.arena().upstream_allocations();
+
+	// the buffers freed by the first array are recycled
+	for (int i = 0; i < 100; ++i)
+		fill();
+	EXPECT_EQ(pool.arena().upstream_allocations(), blocks);
+
+	pool.reset();
+	fill();
+	EXPECT_EQ(pool.arena().upstream_allocations(), blocks);
+}
+
+TEST(pool_allocator, huge_allocation)
+{
+	stc::pool_resource pool;
+
+	// no size class can hold it
+	EXPECT_THROW((void)pool.allocate(std::size_t(-1)), std::bad_alloc);
+	EXPECT_THROW((void)pool.allocate(std::size_t(-1) / 2 + 2), std::bad_alloc);
+
+	stc::pool_allocator<std::uint64_t> alloc(pool);
+	EXPECT_THROW((void)alloc.allocate(std::size_t(-1) / 8), std::bad_array_new_length);
+}
+
+TEST(pool_allocator, rebind)
+{
+	stc::pool_resource pool;
+	stc::pool_allocator<int> ints(pool);
+	stc::pool_allocator<double> doubles(ints);
+	EXPECT_EQ(ints, doubles);
+
+	stc::pool_resource other_pool;
+	EXPECT_NE(ints, stc::pool_allocator<int>(other_pool));
+
+	// the segmented array allocates fixed-size chunks, a perfect fit for the pool
+	stc::segmented_swap_back_array<double, 64, stc::pool_allocator<double>> ssba(doubles);
+	for (int i = 0; i < 1000; ++i)
+		ssba.push_back(i);
+	ssba.clear();
+	ssba.shrink_to_fit();
+	EXPECT_EQ(ssba.capacity(), 0);
+}
@@ -0,0 +1,247 @@
+#include "stc/monotonic_arena.h"
+#include "stc/segmented_swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+
+using test_segmented = stc::segmented_swap_back_array<test_element, 4>;
+
+test_segmented make_test_segmented(size_t count, test_element_data& data)
+{
+	test_segmented ssba;
+	for (size_t i = 0; i < count; ++i)
+	{
+		ssba.emplace_back(i, data);
+	}
+	return ssba;
+}
+
+bool find_test_element_by_id(const test_segmented& ssba, size_t id)
+{
+	for (auto& te : ssba)
+	{
+		if (te.id == id)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace
+
+// Move assignment only moves the elements one by one when an unequal allocator does not propagate.
+static_assert(std::is_nothrow_move_assignable_v<stc::segmented_swap_back_array<int, 4>>);
+static_assert(!std::is_nothrow_move_assignable_v<stc::segmented_swap_back_array<int, 4, stc::arena_allocator<int>>>);
+
+static_assert(std::random_access_iterator<stc::segmented_swap_back_array<int>::iterator>);
+static_assert(std::random_access_iterator<stc::segmented_swap_back_array<int>::const_iterator>);
+
+TEST(segmented_swap_back_array, stable_growth)
+{
+	test_element_data data;
+	test_segmented ssba;
+
+	ssba.emplace_back(0, data);
+	test_element* first = &ssba[0];
+
+	// growing adds chunks, no element is moved
+	for (size_t i = 1; i < 100; ++i)
+		ssba.emplace_back(i, data);
+
+	EXPECT_EQ(&ssba[0], first);
+	EXPECT_EQ(data.move_counter, 0);
+	EXPECT_EQ(data.copy_counter, 0);
+	EXPECT_EQ(ssba.capacity(), 100);
+	EXPECT_EQ(ssba.chunk_count(), 25);
+	for (size_t i = 0; i < 100; ++i)
+		EXPECT_EQ(ssba[i].id, i);
+
+	EXPECT_THROW((void)ssba.at(100), std::out_of_range);
+}
+
+TEST(segmented_swap_back_array, chunks)
+{
+	stc::segmented_swap_back_array<int, 8> ssba;
+	for (int i = 0; i < 20; ++i)
+		ssba.push_back(i);
+
+	EXPECT_EQ(ssba.chunk_count(), 3);
+	EXPECT_EQ(ssba.chunk(0).size(), 8);
+	EXPECT_EQ(ssba.chunk(2).size(), 4);
+	EXPECT_EQ(ssba.chunk(1)[0], 8);
+
+	int sum = 0;
+	for (size_t c = 0; c < ssba.chunk_count(); ++c)
+		sum = std::accumulate(ssba.chunk(c).begin(), ssba.chunk(c).end(), sum);
+	EXPECT_EQ(sum, 190);
+
+	// empty chunks are kept until shrink_to_fit
+	ssba.resize(3);
+	EXPECT_EQ(ssba.capacity(), 24);
+	ssba.shrink_to_fit();
+	EXPECT_EQ(ssba.capacity(), 8);
+}
+
+TEST(segmented_swap_back_array, erase_index)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(10, data);
+	data = {};
+
+	ssba.erase_swap(2);
+	EXPECT_EQ(ssba.size(), 9);
+	EXPECT_FALSE(find_test_element_by_id(ssba, 2));
+	EXPECT_EQ(ssba[2].id, 9);
+	EXPECT_EQ(data.dtor_counter, 1);
+	EXPECT_EQ(data.move_counter, 1);
+
+	ssba.erase_swap(ssba.size() - 1);
+	EXPECT_EQ(ssba.size(), 8);
+	EXPECT_EQ(data.dtor_counter, 2);
+	EXPECT_EQ(data.move_counter, 1);
+}
+
+TEST(segmented_swap_back_array, erase_index_range)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(30, data);
+	data = {};
+
+	// holes are filled with the tail in order, across chunk boundaries
+	ssba.erase_swap(3, 10);
+	EXPECT_EQ(ssba.size(), 20);
+	for (size_t i = 3; i < 13; ++i)
+		EXPECT_EQ(ssba[i].id, i + 17);
+	EXPECT_EQ(data.dtor_counter, 10);
+	EXPECT_EQ(data.move_counter, 10);
+
+	ssba.erase_swap(14, 4);
+	EXPECT_EQ(ssba.size(), 16);
+	EXPECT_EQ(data.dtor_counter, 14);
+	EXPECT_EQ(data.move_counter, 12);
+}
+
+TEST(segmented_swap_back_array, erase_iterator)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(10, data);
+	data = {};
+
+	// delete even ids while iterating
+	for (auto it = ssba.begin(); it != ssba.end();)
+	{
+		if (it->id % 2 == 0)
+			it = ssba.erase_swap(it);
+		else
+			++it;
+	}
+
+	EXPECT_EQ(ssba.size(), 5);
+	for (size_t id = 0; id < 10; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(ssba, id), id % 2 != 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 5);
+}
+
+TEST(segmented_swap_back_array, erase_if)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(10, data);
+	data = {};
+
+	auto removed = ssba.erase_swap_if([](const test_element& te) { return te.id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(ssba.size(), 5);
+	for (size_t id = 0; id < 10; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(ssba, id), id % 2 != 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 5);
+	EXPECT_EQ(data.move_counter, 3);
+}
+
+TEST(segmented_swap_back_array, erase_iterator_range)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(30, data);
+	data = {};
+
+	// same as the index range, first is updated with the first moved element
+	auto it = ssba.erase_swap(ssba.begin() + 3, ssba.begin() + 13);
+	EXPECT_EQ(it, ssba.begin() + 3);
+	EXPECT_EQ(it->id, 20);
+	EXPECT_EQ(ssba.size(), 20);
+	EXPECT_EQ(data.dtor_counter, 10);
+	EXPECT_EQ(data.move_counter, 10);
+
+	// tail range, nothing to move
+	it = ssba.erase_swap(ssba.begin() + 16, ssba.end());
+	EXPECT_EQ(it, ssba.end());
+	EXPECT_EQ(ssba.size(), 16);
+	EXPECT_EQ(data.move_counter, 10);
+
+	EXPECT_EQ(ssba.erase_swap(ssba.begin() + 2, ssba.begin() + 2), ssba.begin() + 2);
+	EXPECT_EQ(ssba.size(), 16);
+}
+
+TEST(segmented_swap_back_array, erase_if_range)
+{
+	test_element_data data;
+	auto ssba = make_test_segmented(20, data);
+	data = {};
+
+	// only [5, 15) is tested, the holes are filled from the end of the range
+	auto removed = ssba.erase_swap_if(ssba.begin() + 5, ssba.begin() + 15, [](const test_element& te) { return te.id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(ssba.size(), 15);
+	for (size_t id = 0; id < 20; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(ssba, id), id < 5 || id >= 15 || id % 2 != 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 5);
+}
+
+TEST(segmented_swap_back_array, copy_and_move)
+{
+	test_element_data data;
+	{
+		auto ssba = make_test_segmented(10, data);
+		test_element* first = &ssba[0];
+		data = {};
+
+		test_segmented copy = ssba;
+		EXPECT_EQ(data.copy_counter, 10);
+		EXPECT_EQ(copy.size(), 10);
+		EXPECT_EQ(copy[9].id, 9);
+
+		// chunks change hands
+		test_segmented moved = std::move(ssba);
+		EXPECT_EQ(&moved[0], first);
+		EXPECT_TRUE(ssba.empty());
+		EXPECT_EQ(ssba.capacity(), 0);
+
+		copy = std::move(moved);
+		EXPECT_EQ(&copy[0], first);
+		EXPECT_EQ(data.dtor_counter, 10);
+		EXPECT_EQ(data.move_counter, 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 20);
+}
+
+TEST(segmented_swap_back_array, algorithms)
+{
+	stc::segmented_swap_back_array<int, 4> ssba = {5, 3, 9, 1, 7, 2, 8};
+
+	std::sort(ssba.begin(), ssba.end());
+	EXPECT_TRUE(std::is_sorted(ssba.cbegin(), ssba.cend()));
+	EXPECT_EQ(ssba.end() - ssba.begin(), 7);
+	EXPECT_EQ(*std::lower_bound(ssba.begin(), ssba.end(), 6), 7);
+}
@@ -0,0 +1,83 @@
+#include "stc/simd_search.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+enum class entity_id : std::uint32_t {};
+
+// Every kernel this processor runs, the portable one included.
+std::vector<stc::simd_search::level> supported_levels()
+{
+	std::vector<stc::simd_search::level> levels;
+	for (auto level : {stc::simd_search::level::portable, stc::simd_search::level::sse2, stc::simd_search::level::avx2, stc::simd_search::level::avx512})
+	{
+		if (level <= stc::simd_search::supported_level())
+			levels.push_back(level);
+	}
+	return levels;
+}
+
+// Searches a match at every position, for every size covering the vector loops and the scalar tail.
+template<typename T>
+void test_every_position()
+{
+	for (auto level : supported_levels())
+	{
+		for (std::size_t size = 0; size <= 300; ++size)
+		{
+			std::vector<T> values(size, T(0x5a));
+			T needle = T(-3);
+			EXPECT_EQ(stc::simd_search::find(values.data(), size, needle, level), size);
+
+			for (std::size_t i = 0; i < size; i += 7)
+			{
+				values[i] = needle;
+				EXPECT_EQ(stc::simd_search::find(values.data(), size, needle, level), i) << "level " << int(level) << ", size " << size;
+				values[i] = T(0x5a);
+			}
+		}
+	}
+}
+
+} // namespace
+
+static_assert(stc::simd_searchable<std::uint32_t>);
+static_assert(stc::simd_searchable<entity_id>);
+static_assert(!stc::simd_searchable<bool>);
+static_assert(!stc::simd_searchable<float>);
+
+TEST(simd_search, every_size_and_position)
+{
+	test_every_position<std::int8_t>();
+	test_every_position<std::uint16_t>();
+	test_every_position<std::int32_t>();
+	test_every_position<std::uint64_t>();
+}
+
+TEST(simd_search, partial_matches)
+{
+	// only half of each 64-bit value matches, which must not count as equal
+	std::vector<std::uint64_t> values(100);
+	for (std::size_t i = 0; i < values.size(); ++i)
+		values[i] = i % 2 ? 0x0000'0001'ffff'ffff : 0xffff'ffff'0000'0002;
+	values[97] = 0xffff'ffff'ffff'ffff;
+
+	for (auto level : supported_levels())
+		EXPECT_EQ(stc::simd_search::find(values.data(), values.size(), ~std::uint64_t(0), level), 97);
+}
+
+TEST(simd_search, enumerations)
+{
+	std::vector<entity_id> ids;
+	for (std::uint32_t i = 0; i < 1000; ++i)
+		ids.push_back(entity_id(i * 3));
+
+	for (auto level : supported_levels())
+	{
+		EXPECT_EQ(stc::simd_search::find(ids.data(), ids.size(), entity_id(2997), level), 999);
+		EXPECT_EQ(stc::simd_search::find(ids.data(), ids.size(), entity_id(1), level), ids.size());
+	}
+}
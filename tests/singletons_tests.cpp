@@ -1,7 +1,17 @@
+#include "stc/concurrent_explicit_singleton.h"
+#include "stc/constinit_singleton.h"
 #include "stc/eager_singleton.h"
 #include "stc/explicit_singleton.h"
 #include "stc/lazy_singleton.h"
+#include "stc/sharded_singleton.h"
+#include "stc/thread_local_singleton.h"
+#include "stc/versioned_singleton.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -17,6 +27,62 @@ struct counted_element
 	std::size_t count = next_count();
 };
 
+// Counts its live instances, and checks that they are never used after destruction.
+struct tracked_instance
+{
+	static inline std::atomic<int> live = 0;
+	static inline std::atomic<int> constructed = 0;
+
+	explicit tracked_instance(int value) : value(value) { ++live; ++constructed; }
+	~tracked_instance() { value = -1; --live; }
+
+	int value;
+};
+
+// Per-thread counter, updated by its owner only.
+struct thread_counter
+{
+	std::atomic<std::size_t> value = 0;
+
+	void increment() { value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+};
+
+// Concurrent explicit singleton, using the CRTP idiom.
+class concurrent_config : public stc::concurrent_explicit_singleton<concurrent_config>
+{
+	friend concurrent_explicit_singleton;
+	explicit concurrent_config(int value) : value(value) {}
+
+public:
+
+	int value;
+};
+
+// Sharded statistics, using the CRTP idiom.
+class sharded_stats : public stc::sharded_singleton<sharded_stats, 4>
+{
+	friend sharded_singleton;
+	sharded_stats() = default;
+
+public:
+
+	std::atomic<std::size_t> count = 0;
+};
+
+// Constant-initialized configuration, using the CRTP idiom.
+class constant_config : public stc::constinit_singleton<constant_config>
+{
+	friend constinit_singleton;
+	constexpr constant_config() = default;
+
+public:
+
+	int frame_rate = 60;
+};
+
+// Dynamically initialized, possibly before the singleton would be with eager_singleton.
+const int frame_rate_at_static_init = constant_config::instance().frame_rate;
+
 } // namespace
 
 TEST(singletons, eager_singleton)
@@ -76,3 +142,269 @@ TEST(singletons, lazy_singleton)
 	auto& elem2 = singleton::instance();
 	EXPECT_EQ(std::addressof(elem), std::addressof(elem2));
 }
+
+TEST(singletons, concurrent_explicit_singleton)
+{
+	using singleton = stc::concurrent_explicit_singleton<counted_element>;
+
+	EXPECT_FALSE(singleton::instance_constructed());
+	EXPECT_EQ(singleton::try_instance(), nullptr);
+
+	counted_element before;
+	auto& elem = singleton::construct_instance();
+	counted_element after;
+	EXPECT_TRUE(singleton::instance_constructed());
+	EXPECT_TRUE(before.count < elem.count && elem.count < after.count);
+	EXPECT_EQ(std::addressof(elem), std::addressof(singleton::instance()));
+	EXPECT_EQ(std::addressof(elem), singleton::try_instance());
+
+	singleton::destruct_instance();
+	singleton::destruct_instance();
+	EXPECT_FALSE(singleton::instance_constructed());
+	EXPECT_EQ(singleton::try_instance(), nullptr);
+}
+
+TEST(singletons, concurrent_explicit_singleton_crtp)
+{
+	EXPECT_EQ(concurrent_config::try_instance(), nullptr);
+	EXPECT_EQ(concurrent_config::construct_instance(1).value, 1);
+	EXPECT_EQ(concurrent_config::construct_instance(2).value, 2);
+	EXPECT_EQ(concurrent_config::instance().value, 2);
+
+	concurrent_config::destruct_instance();
+	EXPECT_FALSE(concurrent_config::instance_constructed());
+}
+
+TEST(singletons, concurrent_explicit_singleton_races)
+{
+	using singleton = stc::concurrent_explicit_singleton<tracked_instance>;
+
+	// readers wait for the first construction, then only see fully constructed instances
+	std::atomic<bool> stop = false;
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; ++t)
+	{
+		readers.emplace_back([&]()
+		{
+			while (!singleton::instance_constructed())
+				std::this_thread::yield();
+			while (!stop.load(std::memory_order_relaxed))
+				EXPECT_EQ(singleton::instance().value, 42);
+		});
+	}
+	singleton::construct_instance(42);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	stop = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	// concurrent constructions and destructions are applied one at a time
+	std::vector<std::thread> writers;
+	for (int t = 0; t < 8; ++t)
+	{
+		writers.emplace_back([t]()
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				if (i % 10 == 9)
+					singleton::destruct_instance();
+				else
+					singleton::construct_instance(t);
+				EXPECT_LE(tracked_instance::live, 1);
+			}
+		});
+	}
+	for (auto& writer : writers)
+		writer.join();
+
+	EXPECT_EQ(tracked_instance::constructed, 1 + 8 * 900);
+	EXPECT_EQ(tracked_instance::live, singleton::instance_constructed() ? 1 : 0);
+	singleton::destruct_instance();
+	EXPECT_EQ(tracked_instance::live, 0);
+}
+
+TEST(singletons, versioned_singleton)
+{
+	using singleton = stc::versioned_singleton<tracked_instance>;
+	ASSERT_EQ(tracked_instance::live, 0);
+
+	EXPECT_FALSE(singleton::instance_constructed());
+	EXPECT_FALSE(singleton::read());
+
+	singleton::construct_instance(1);
+	EXPECT_TRUE(singleton::instance_constructed());
+	{
+		auto first = singleton::read();
+		EXPECT_EQ(first->value, 1);
+
+		// the version held by a reader survives its replacement
+		singleton::construct_instance(2);
+		EXPECT_EQ(first->value, 1);
+		EXPECT_EQ(singleton::read()->value, 2);
+		EXPECT_EQ(tracked_instance::live, 2);
+		EXPECT_EQ(singleton::retired_count(), 1u);
+	}
+
+	singleton::synchronize();
+	EXPECT_EQ(singleton::retired_count(), 0u);
+	EXPECT_EQ(tracked_instance::live, 1);
+
+	singleton::destruct_instance();
+	EXPECT_FALSE(singleton::instance_constructed());
+	EXPECT_FALSE(singleton::read());
+	singleton::synchronize();
+	EXPECT_EQ(tracked_instance::live, 0);
+}
+
+TEST(singletons, versioned_singleton_reload_storm)
+{
+	using singleton = stc::versioned_singleton<tracked_instance>;
+	singleton::construct_instance(0);
+
+	// readers only ever see live versions, including in nested guards
+	std::atomic<bool> stop = false;
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; ++t)
+	{
+		readers.emplace_back([&]()
+		{
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				auto outer = singleton::read();
+				int value = outer->value;
+				EXPECT_GE(value, 0);
+				auto inner = singleton::read();
+				EXPECT_GE(inner->value, value);
+				EXPECT_EQ(outer->value, value);
+			}
+		});
+	}
+	for (int i = 1; i <= 2000; ++i)
+		singleton::construct_instance(i);
+	stop = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	singleton::synchronize();
+	EXPECT_EQ(singleton::retired_count(), 0u);
+	EXPECT_EQ(tracked_instance::live, 1);
+	singleton::destruct_instance();
+	singleton::synchronize();
+	EXPECT_EQ(tracked_instance::live, 0);
+}
+
+TEST(singletons, thread_local_singleton)
+{
+	using singleton = stc::thread_local_singleton<thread_counter>;
+
+	auto& local = singleton::instance();
+	EXPECT_EQ(std::addressof(local), std::addressof(singleton::instance()));
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&local) % stc::destructive_interference, 0u);
+	local.increment();
+
+	// each thread gets its own instance, still combined after the thread exits
+	std::vector<std::thread> threads;
+	std::vector<thread_counter*> instances(8);
+	for (std::size_t t = 0; t < instances.size(); ++t)
+	{
+		threads.emplace_back([&instances, t]()
+		{
+			instances[t] = &singleton::instance();
+			for (std::size_t i = 0; i <= t; ++i)
+				singleton::instance().increment();
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	for (auto* instance : instances)
+		EXPECT_NE(instance, &local);
+	EXPECT_EQ(singleton::instance_count(), 9u);
+
+	auto total = singleton::combine(std::size_t(0), [](std::size_t sum, const thread_counter& counter) { return sum + counter.value.load(); });
+	EXPECT_EQ(total, 1u + 36u);
+
+	std::size_t visited = 0;
+	singleton::for_each_instance([&](thread_counter& counter) { ++visited; counter.value = 0; });
+	EXPECT_EQ(visited, 9u);
+	EXPECT_EQ(local.value, 0u);
+}
+
+TEST(singletons, thread_local_singleton_concurrent_combine)
+{
+	struct tag_counter : thread_counter {};
+	using singleton = stc::thread_local_singleton<tag_counter>;
+
+	// combining while threads register and update their instances
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			for (int i = 0; i < 10000; ++i)
+				singleton::instance().increment();
+		});
+	}
+	std::size_t last = 0;
+	while (singleton::instance_count() < 4 || last < 40000)
+	{
+		auto total = singleton::combine(std::size_t(0), [](std::size_t sum, const tag_counter& counter) { return sum + counter.value.load(std::memory_order_relaxed); });
+		EXPECT_LE(total, 40000u);
+		last = total;
+	}
+	for (auto& thread : threads)
+		thread.join();
+	EXPECT_EQ(last, 40000u);
+}
+
+TEST(singletons, sharded_singleton)
+{
+	EXPECT_EQ(sharded_stats::shard_count, 4u);
+	EXPECT_GE(sharded_stats::shard_alignment, 64u);
+
+	// every shard is on cache lines of its own
+	for (std::size_t i = 0; i < sharded_stats::shard_count; ++i)
+	{
+		auto address = reinterpret_cast<std::uintptr_t>(&sharded_stats::shard(i));
+		EXPECT_EQ(address % sharded_stats::shard_alignment, 0u);
+		if (i > 0)
+		{
+			EXPECT_GE(address - reinterpret_cast<std::uintptr_t>(&sharded_stats::shard(i - 1)), sharded_stats::shard_alignment);
+		}
+	}
+
+	auto index = sharded_stats::shard_index();
+	EXPECT_LT(index, sharded_stats::shard_count);
+
+	// writes from any thread land in some shard, and are all reduced
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t)
+	{
+		threads.emplace_back([]()
+		{
+			for (int i = 0; i < 1000; ++i)
+				sharded_stats::local().count.fetch_add(1, std::memory_order_relaxed);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	auto total = sharded_stats::reduce(std::size_t(0), [](std::size_t sum, const sharded_stats& s) { return sum + s.count.load(); });
+	EXPECT_EQ(total, 8000u);
+
+	std::size_t visited = 0;
+	sharded_stats::for_each_shard([&](sharded_stats& s) { ++visited; s.count = 0; });
+	EXPECT_EQ(visited, 4u);
+	EXPECT_EQ(sharded_stats::reduce(std::size_t(0), [](std::size_t sum, const sharded_stats& s) { return sum + s.count.load(); }), 0u);
+}
+
+TEST(singletons, constinit_singleton)
+{
+	// the instance is initialized before any dynamic initialization
+	EXPECT_EQ(frame_rate_at_static_init, 60);
+
+	auto& config = constant_config::instance();
+	EXPECT_EQ(std::addressof(config), std::addressof(constant_config::instance()));
+	config.frame_rate = 144;
+	EXPECT_EQ(constant_config::instance().frame_rate, 144);
+}
@@ -0,0 +1,97 @@
+#include "stc/slot_map.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+
+TEST(slot_map, insert_and_find)
+{
+	test_element_data data;
+	stc::slot_map<test_element> map;
+
+	auto h0 = map.emplace(0, data);
+	auto h1 = map.emplace(1, data);
+	auto h2 = map.insert(test_element(2, data));
+
+	EXPECT_EQ(map.size(), 3);
+	EXPECT_TRUE(map.contains(h0) && map.contains(h1) && map.contains(h2));
+	EXPECT_EQ(map[h0].id, 0);
+	EXPECT_EQ(map[h1].id, 1);
+	EXPECT_EQ(map.find(h2)->id, 2);
+	EXPECT_EQ(map.handle_at(1), h1);
+
+	EXPECT_FALSE(map.contains({}));
+	EXPECT_EQ(map.find({}), nullptr);
+	EXPECT_EQ(data.copy_counter, 0);
+}
+
+TEST(slot_map, erase_keeps_handles)
+{
+	test_element_data data;
+	stc::slot_map<test_element> map;
+	std::vector<stc::slot_map<test_element>::handle> handles;
+	map.reserve(10);
+	for (size_t i = 0; i < 10; ++i)
+		handles.push_back(map.emplace(i, data));
+
+	// erasing the first element moves the last one into its position
+	EXPECT_TRUE(map.erase(handles[0]));
+	EXPECT_FALSE(map.erase(handles[0]));
+	EXPECT_FALSE(map.contains(handles[0]));
+	EXPECT_EQ(map.find(handles[0]), nullptr);
+	EXPECT_EQ(map.size(), 9);
+	EXPECT_EQ(data.dtor_counter, 1);
+	EXPECT_EQ(data.move_counter, 1);
+
+	EXPECT_TRUE(map.erase(handles[4]));
+	EXPECT_TRUE(map.erase(handles[8]));
+	for (size_t i = 0; i < 10; ++i)
+	{
+		if (i == 0 || i == 4 || i == 8)
+			continue;
+		ASSERT_TRUE(map.contains(handles[i]));
+		EXPECT_EQ(map[handles[i]].id, i);
+	}
+
+	for (size_t i = 0; i < map.size(); ++i)
+	{
+		EXPECT_EQ(map[map.handle_at(i)].id, map.data()[i].id);
+	}
+}
+
+TEST(slot_map, slot_reuse)
+{
+	test_element_data data;
+	stc::slot_map<test_element> map;
+
+	auto h0 = map.emplace(0, data);
+	map.erase(h0);
+	auto h1 = map.emplace(1, data);
+
+	// same slot, different generation
+	EXPECT_EQ(h0.index, h1.index);
+	EXPECT_NE(h0, h1);
+	EXPECT_FALSE(map.contains(h0));
+	EXPECT_EQ(map[h1].id, 1);
+}
+
+TEST(slot_map, clear)
+{
+	test_element_data data;
+	stc::slot_map<test_element> map;
+	std::vector<stc::slot_map<test_element>::handle> handles;
+	map.reserve(5);
+	for (size_t i = 0; i < 5; ++i)
+		handles.push_back(map.emplace(i, data));
+
+	map.clear();
+
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(data.dtor_counter, 5);
+	for (auto h : handles)
+	{
+		EXPECT_FALSE(map.contains(h));
+	}
+
+	auto h = map.emplace(5, data);
+	EXPECT_EQ(map[h].id, 5);
+	EXPECT_EQ(map.size(), 1);
+}
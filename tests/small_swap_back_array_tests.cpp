@@ -0,0 +1,212 @@
+#include "stc/monotonic_arena.h"
+#include "stc/small_swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using test_ssba = stc::small_swap_back_array<test_element, 8>;
+
+test_ssba make_test_ssba(size_t count, test_element_data& data)
+{
+	test_ssba ssba;
+	ssba.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		ssba.emplace_back(i, data);
+	}
+	return ssba;
+}
+
+bool find_test_element_by_id(const test_ssba& ssba, size_t id)
+{
+	for (auto& te : ssba)
+	{
+		if (te.id == id)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace
+
+// Move assignment only allocates when an unequal allocator does not propagate.
+static_assert(std::is_nothrow_move_assignable_v<stc::small_swap_back_array<int, 8>>);
+static_assert(!std::is_nothrow_move_assignable_v<stc::small_swap_back_array<int, 8, stc::arena_allocator<int>>>);
+
+TEST(small_swap_back_array, inline_storage)
+{
+	test_element_data data;
+	test_ssba ssba;
+
+	for (size_t i = 0; i < 8; ++i)
+		ssba.emplace_back(i, data);
+
+	EXPECT_TRUE(ssba.is_inline());
+	EXPECT_EQ(ssba.capacity(), 8);
+	EXPECT_EQ(data.move_counter, 0);
+
+	// spills to the heap, moving the inline elements
+	ssba.emplace_back(8, data);
+
+	EXPECT_FALSE(ssba.is_inline());
+	EXPECT_EQ(ssba.size(), 9);
+	EXPECT_EQ(data.move_counter, 8);
+	for (size_t i = 0; i < 9; ++i)
+	{
+		EXPECT_EQ(ssba[i].id, i);
+	}
+
+	// back inline when small enough
+	ssba.erase_swap(0, 3);
+	ssba.shrink_to_fit();
+
+	EXPECT_TRUE(ssba.is_inline());
+	EXPECT_EQ(ssba.size(), 6);
+	EXPECT_EQ(data.dtor_counter, 8 + 3 + 6);
+}
+
+TEST(small_swap_back_array, copy_and_move)
+{
+	test_element_data data;
+	auto small = make_test_ssba(4, data);
+	auto large = make_test_ssba(20, data);
+	auto large_data = large.data();
+	data = {};
+
+	test_ssba small_copy = small;
+	test_ssba large_copy = large;
+	EXPECT_EQ(data.copy_counter, 24);
+	EXPECT_EQ(small_copy.size(), 4);
+	EXPECT_EQ(large_copy.size(), 20);
+
+	// inline elements are moved one by one, heap storage is stolen
+	test_ssba small_moved = std::move(small);
+	test_ssba large_moved = std::move(large);
+	EXPECT_EQ(data.move_counter, 4);
+	EXPECT_EQ(large_moved.data(), large_data);
+	EXPECT_TRUE(small.empty() && large.empty());
+	EXPECT_TRUE(large.is_inline());
+
+	small_moved = std::move(large_moved);
+	EXPECT_EQ(small_moved.size(), 20);
+	EXPECT_EQ(small_moved.data(), large_data);
+
+	large_copy = {test_element(100, data)};
+	EXPECT_EQ(large_copy.size(), 1);
+	EXPECT_EQ(large_copy[0].id, 100);
+}
+
+TEST(small_swap_back_array, erase_index)
+{
+	test_element_data data;
+	auto ssba = make_test_ssba(10, data);
+	data = {};
+
+	size_t erased_id = ssba[2].id;
+	ssba.erase_swap(2);
+	EXPECT_EQ(ssba.size(), 9);
+	EXPECT_FALSE(find_test_element_by_id(ssba, erased_id));
+	EXPECT_EQ(data.dtor_counter, 1);
+	EXPECT_EQ(data.move_counter, 1);
+
+	erased_id = ssba[ssba.size() - 1].id;
+	ssba.erase_swap(ssba.size() - 1);
+	EXPECT_EQ(ssba.size(), 8);
+	EXPECT_FALSE(find_test_element_by_id(ssba, erased_id));
+	EXPECT_EQ(data.dtor_counter, 2);
+	EXPECT_EQ(data.move_counter, 1);
+
+	// selects the index overload, not the iterator one
+	erased_id = ssba[0].id;
+	ssba.erase_swap(0);
+	EXPECT_EQ(ssba.size(), 7);
+	EXPECT_FALSE(find_test_element_by_id(ssba, erased_id));
+	EXPECT_EQ(data.dtor_counter, 3);
+	EXPECT_EQ(data.move_counter, 2);
+}
+
+TEST(small_swap_back_array, erase_index_range)
+{
+	test_element_data data;
+	auto ssba = make_test_ssba(30, data);
+	data = {};
+
+	ssba.erase_swap(3, 10);
+	EXPECT_EQ(ssba.size(), 20);
+	for (size_t id = 3; id < 13; ++id)
+	{
+		EXPECT_FALSE(find_test_element_by_id(ssba, id));
+	}
+	EXPECT_EQ(data.dtor_counter, 10);
+	EXPECT_EQ(data.move_counter, 10);
+
+	ssba.erase_swap(14, 4);
+	EXPECT_EQ(ssba.size(), 16);
+	EXPECT_EQ(data.dtor_counter, 14);
+	EXPECT_EQ(data.move_counter, 12);
+}
+
+TEST(small_swap_back_array, erase_iterator)
+{
+	test_element_data data;
+	auto ssba = make_test_ssba(6, data);
+	data = {};
+
+	// delete even ids while iterating
+	for (auto it = ssba.begin(); it != ssba.end();)
+	{
+		if (it->id % 2 == 0)
+			it = ssba.erase_swap(it);
+		else
+			++it;
+	}
+
+	EXPECT_EQ(ssba.size(), 3);
+	for (size_t id = 0; id < 6; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(ssba, id), id % 2 != 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 3);
+}
+
+TEST(small_swap_back_array, erase_iterator_range)
+{
+	test_element_data data;
+	auto ssba = make_test_ssba(8, data);
+	data = {};
+
+	auto it = ssba.erase_swap(ssba.begin() + 1, ssba.begin() + 3);
+	EXPECT_EQ(it, ssba.begin() + 1);
+	EXPECT_EQ(ssba.size(), 6);
+	EXPECT_FALSE(find_test_element_by_id(ssba, 1));
+	EXPECT_FALSE(find_test_element_by_id(ssba, 2));
+	EXPECT_EQ(data.move_counter, 2);
+
+	it = ssba.erase_swap(ssba.end() - 2, ssba.end());
+	EXPECT_EQ(it, ssba.end());
+	EXPECT_EQ(ssba.size(), 4);
+	EXPECT_EQ(data.dtor_counter, 4);
+	EXPECT_EQ(data.move_counter, 2);
+}
+
+TEST(small_swap_back_array, erase_if)
+{
+	test_element_data data;
+	auto ssba = make_test_ssba(10, data);
+	data = {};
+
+	auto removed = ssba.erase_swap_if([](const test_element& te) { return te.id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(ssba.size(), 5);
+	for (size_t id = 0; id < 10; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(ssba, id), id % 2 != 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 5);
+	EXPECT_EQ(data.move_counter, 3);
+}
@@ -0,0 +1,204 @@
+#include "stc/snapshot.h"
+#include "stc/swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+
+struct pod_element
+{
+	std::uint32_t id;
+	float values[5];
+};
+
+// Not trivially copyable nor default constructible, serialized through snapshot_traits.
+struct named_element : test_element
+{
+	named_element(size_t id, test_element_data& data, std::string name)
+		: test_element(id, data), name(std::move(name)) {}
+
+	std::string name;
+};
+
+// Trivially copyable, without default constructor.
+struct id_element
+{
+	explicit id_element(std::uint32_t id) : id(id) {}
+
+	std::uint32_t id;
+};
+
+// Trivially copyable, counting its default constructions.
+struct default_counted_element
+{
+	static inline int default_constructions = 0;
+
+	default_counted_element() { ++default_constructions; }
+	default_counted_element(std::uint32_t id) : id(id) {}
+
+	std::uint32_t id = 0;
+};
+
+test_element_data* read_data = nullptr;
+
+} // namespace
+
+template<>
+struct stc::snapshot_traits<named_element>
+{
+	static void write(std::ostream& out, const named_element& value)
+	{
+		auto length = std::uint32_t(value.name.size());
+		out.write(reinterpret_cast<const char*>(&value.id), sizeof(value.id));
+		out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		out.write(value.name.data(), length);
+	}
+
+	static named_element read(std::istream& in)
+	{
+		size_t id = 0;
+		std::uint32_t length = 0;
+		in.read(reinterpret_cast<char*>(&id), sizeof(id));
+		in.read(reinterpret_cast<char*>(&length), sizeof(length));
+		std::string name(in ? length : 0, '\0');
+		in.read(name.data(), std::streamsize(name.size()));
+		return named_element(id, *read_data, std::move(name));
+	}
+};
+
+static_assert(stc::snapshot_serializable<pod_element>);
+static_assert(stc::snapshot_serializable<named_element>);
+static_assert(stc::snapshot_serializable<id_element>);
+static_assert(std::is_trivially_copyable_v<id_element> && std::is_trivially_copyable_v<default_counted_element>);
+static_assert(!stc::snapshot_serializable<std::string>);
+
+TEST(snapshot, trivially_copyable)
+{
+	// spans several read blocks
+	stc::swap_back_array<pod_element> written;
+	for (std::uint32_t i = 0; i < 100'000; ++i)
+		written.push_back({i, {float(i), 1.f, 2.f, 3.f, -float(i)}});
+	written.erase_swap(0, 10);
+
+	std::stringstream stream;
+	stc::write_snapshot(stream, written);
+
+	stc::swap_back_array<pod_element> read = {{42, {}}};
+	stc::read_snapshot(stream, read);
+	ASSERT_EQ(read.size(), written.size());
+	for (size_t i = 0; i < read.size(); ++i)
+	{
+		ASSERT_EQ(read[i].id, written[i].id);
+		ASSERT_EQ(read[i].values[4], written[i].values[4]);
+	}
+
+	// empty
+	std::stringstream empty_stream;
+	stc::write_snapshot(empty_stream, stc::swap_back_array<pod_element>());
+	stc::read_snapshot(empty_stream, read);
+	EXPECT_TRUE(read.empty());
+}
+
+TEST(snapshot, trivially_copyable_without_default_construction)
+{
+	stc::swap_back_array<id_element> written;
+	stc::swap_back_array<default_counted_element> counted_written;
+	for (std::uint32_t i = 0; i < 100'000; ++i)
+	{
+		written.emplace_back(i);
+		counted_written.emplace_back(i);
+	}
+
+	std::stringstream stream;
+	stc::write_snapshot(stream, written);
+	stc::swap_back_array<id_element> read;
+	stc::read_snapshot(stream, read);
+	ASSERT_EQ(read.size(), written.size());
+	for (size_t i = 0; i < read.size(); ++i)
+		ASSERT_EQ(read[i].id, written[i].id);
+
+	std::stringstream counted_stream;
+	stc::write_snapshot(counted_stream, counted_written);
+	stc::swap_back_array<default_counted_element> counted_read;
+	stc::read_snapshot(counted_stream, counted_read);
+	EXPECT_EQ(default_counted_element::default_constructions, 0);
+	ASSERT_EQ(counted_read.size(), counted_written.size());
+	EXPECT_EQ(counted_read.back().id, counted_written.back().id);
+}
+
+TEST(snapshot, customization_point)
+{
+	test_element_data data;
+	stc::swap_back_array<named_element> written;
+	for (size_t i = 0; i < 20; ++i)
+		written.emplace_back(i, data, std::string(i, 'a'));
+
+	std::stringstream stream;
+	stc::write_snapshot(stream, written);
+	EXPECT_EQ(data.copy_counter, 0);
+
+	test_element_data restored_data;
+	read_data = &restored_data;
+	{
+		stc::swap_back_array<named_element> read;
+		stc::read_snapshot(stream, read);
+		ASSERT_EQ(read.size(), 20);
+		for (size_t i = 0; i < 20; ++i)
+		{
+			EXPECT_EQ(read[i].id, i);
+			EXPECT_EQ(read[i].name, std::string(i, 'a'));
+		}
+
+		// constructed in the reserved storage, never default constructed nor copied
+		EXPECT_EQ(restored_data.ctor_counter, 20);
+		EXPECT_EQ(restored_data.copy_counter, 0);
+		EXPECT_EQ(read.capacity(), 20);
+	}
+	EXPECT_EQ(restored_data.ctor_counter + restored_data.move_counter, restored_data.dtor_counter);
+	read_data = nullptr;
+}
+
+TEST(snapshot, invalid_streams)
+{
+	stc::swap_back_array<std::uint32_t> written = {1, 2, 3, 4};
+	std::stringstream stream;
+	stc::write_snapshot(stream, written);
+	auto bytes = stream.str();
+
+	// other element type
+	{
+		std::stringstream in(bytes);
+		stc::swap_back_array<std::uint64_t> read;
+		EXPECT_THROW(stc::read_snapshot(in, read), std::runtime_error);
+	}
+
+	// truncated
+	{
+		std::stringstream in(bytes.substr(0, bytes.size() - 2));
+		stc::swap_back_array<std::uint32_t> read;
+		EXPECT_THROW(stc::read_snapshot(in, read), std::runtime_error);
+	}
+
+	// corrupt count, larger than the stream
+	{
+		auto corrupt = bytes;
+		std::uint64_t count = std::uint64_t(1) << 62;
+		corrupt.replace(16, sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+		std::stringstream in(corrupt);
+		stc::swap_back_array<std::uint32_t> read;
+		EXPECT_THROW(stc::read_snapshot(in, read), std::runtime_error);
+		EXPECT_EQ(read.capacity(), 0);
+	}
+
+	// not a snapshot
+	{
+		std::stringstream in(std::string(64, 'x'));
+		stc::swap_back_array<std::uint32_t> read;
+		EXPECT_THROW(stc::read_snapshot(in, read), std::runtime_error);
+	}
+}
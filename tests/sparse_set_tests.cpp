@@ -0,0 +1,65 @@
+#include "stc/sparse_set.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST(sparse_set, insert_erase_contains)
+{
+	stc::sparse_set<std::uint32_t> set;
+
+	EXPECT_TRUE(set.insert(5));
+	EXPECT_TRUE(set.insert(70'000));
+	EXPECT_TRUE(set.insert(7));
+	EXPECT_FALSE(set.insert(5));
+	EXPECT_EQ(set.size(), 3);
+	EXPECT_TRUE(set.contains(5) && set.contains(7) && set.contains(70'000));
+	EXPECT_FALSE(set.contains(6));
+	EXPECT_FALSE(set.contains(stc::sparse_set<std::uint32_t>::max_key));
+
+	// only the pages of the keys in use are allocated
+	EXPECT_EQ(set.page_count(), 2);
+
+	// the last key moves into the dense position of the erased one
+	EXPECT_TRUE(set.erase(5));
+	EXPECT_FALSE(set.erase(5));
+	EXPECT_FALSE(set.contains(5));
+	EXPECT_EQ(set.position(7), 0);
+	EXPECT_EQ(set.position(70'000), 1);
+	EXPECT_EQ(set.position(5), set.size());
+	EXPECT_EQ(std::vector<std::uint32_t>(set.begin(), set.end()), (std::vector<std::uint32_t>{7, 70'000}));
+
+	set.clear();
+	EXPECT_TRUE(set.empty());
+	EXPECT_FALSE(set.contains(7));
+	EXPECT_EQ(set.page_count(), 2);
+	EXPECT_TRUE(set.insert(7));
+	EXPECT_EQ(set.position(7), 0);
+}
+
+TEST(sparse_set, matches_std_set)
+{
+	stc::sparse_set<std::uint16_t, 64> set;
+	std::set<std::uint16_t> expected;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<unsigned> key_distribution(0, 5000);
+
+	for (int i = 0; i < 20'000; ++i)
+	{
+		auto key = static_cast<std::uint16_t>(key_distribution(rng));
+		if (rng() % 3 == 0)
+			EXPECT_EQ(set.erase(key), expected.erase(key) == 1);
+		else
+			EXPECT_EQ(set.insert(key), expected.insert(key).second);
+	}
+
+	ASSERT_EQ(set.size(), expected.size());
+	for (std::size_t i = 0; i < set.size(); ++i)
+		EXPECT_EQ(set.position(set.data()[i]), i);
+
+	std::vector<std::uint16_t> keys(set.begin(), set.end());
+	std::sort(keys.begin(), keys.end());
+	EXPECT_TRUE(std::equal(keys.begin(), keys.end(), expected.begin(), expected.end()));
+}
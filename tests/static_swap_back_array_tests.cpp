@@ -0,0 +1,160 @@
+#include "stc/static_swap_back_array.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template <std::size_t Capacity>
+constexpr bool contains(const stc::static_swap_back_array<int, Capacity>& ssba, int value)
+{
+	for (int v : ssba)
+	{
+		if (v == value)
+			return true;
+	}
+	return false;
+}
+
+// Non-trivial type, stored in union storage.
+struct constexpr_element
+{
+	constexpr constexpr_element(int value) : value(value) {}
+	constexpr constexpr_element(const constexpr_element& other) : value(other.value) {}
+	constexpr constexpr_element& operator=(const constexpr_element& other) { value = other.value; return *this; }
+	constexpr ~constexpr_element() {}
+
+	int value;
+};
+
+constexpr auto primes_below_50 = []
+{
+	stc::static_swap_back_array<int, 48> values;
+	for (int i = 2; i < 50; ++i)
+		values.push_back(i);
+
+	values.erase_swap_if([](int value)
+	{
+		for (int d = 2; d * d <= value; ++d)
+		{
+			if (value % d == 0)
+				return true;
+		}
+		return false;
+	});
+	return values;
+}();
+
+} // namespace
+
+// Trivial types, usable as constexpr variables
+
+static_assert(std::is_trivially_copyable_v<stc::static_swap_back_array<int, 4>>);
+static_assert(!std::is_trivially_copyable_v<stc::static_swap_back_array<constexpr_element, 4>>);
+
+static_assert(primes_below_50.size() == 15);
+static_assert(contains(primes_below_50, 2) && contains(primes_below_50, 47));
+static_assert(!contains(primes_below_50, 4) && !contains(primes_below_50, 49));
+
+static_assert([]
+{
+	stc::static_swap_back_array<int, 4> ssba = {0, 1, 2, 3};
+	if (!ssba.full() || ssba.try_push_back(4) != nullptr)
+		return false;
+
+	ssba.erase_swap(1);
+	if (ssba.size() != 3 || ssba[1] != 3)
+		return false;
+
+	int* added = ssba.try_emplace_back(5);
+	return added && *added == 5 && ssba.size() == 4;
+}());
+
+static_assert([]
+{
+	stc::static_swap_back_array<int, 10> ssba = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	ssba.erase_swap(2, 3);
+	if (ssba.size() != 7 || contains(ssba, 2) || contains(ssba, 3) || contains(ssba, 4))
+		return false;
+
+	auto it = ssba.erase_swap(ssba.begin());
+	if (it != ssba.begin() || ssba.size() != 6 || contains(ssba, 0))
+		return false;
+
+	it = ssba.erase_swap(ssba.begin() + 1, ssba.begin() + 3);
+	if (it != ssba.begin() + 1 || ssba.size() != 4)
+		return false;
+
+	auto copy = ssba;
+	auto removed = copy.erase_swap_if(copy.begin(), copy.end(), [](int) { return true; });
+	return removed == 4 && copy.empty() && ssba.size() == 4;
+}());
+
+// Non-trivial types, usable within constant evaluation
+
+static_assert([]
+{
+	stc::static_swap_back_array<constexpr_element, 8> ssba;
+	for (int i = 0; i < 8; ++i)
+		ssba.emplace_back(i);
+
+	ssba.erase_swap(0);
+	ssba.erase_swap(ssba.begin() + 1, ssba.begin() + 3);
+	auto removed = ssba.erase_swap_if([](const constexpr_element& e) { return e.value % 2 == 0; });
+
+	auto copy = ssba;
+	return removed == 2 && copy.size() == 3 && copy.try_push_back(constexpr_element(8)) != nullptr;
+}());
+
+TEST(static_swap_back_array, element_lifetime)
+{
+	test_element_data data;
+	{
+		stc::static_swap_back_array<test_element, 8> ssba;
+		for (size_t i = 0; i < 8; ++i)
+			ssba.emplace_back(i, data);
+
+		EXPECT_EQ(ssba.try_emplace_back(8, data), nullptr);
+		EXPECT_EQ(data.ctor_counter, 8);
+
+		ssba.erase_swap(2);
+		EXPECT_EQ(data.dtor_counter, 1);
+		EXPECT_EQ(data.move_counter, 1);
+
+		auto removed = ssba.erase_swap_if([](const test_element& te) { return te.id % 2 == 0; });
+		EXPECT_EQ(removed, 3);
+		EXPECT_EQ(ssba.size(), 4);
+		EXPECT_EQ(data.dtor_counter, 4);
+
+		auto copy = ssba;
+		EXPECT_EQ(data.copy_counter, 4);
+	}
+
+	// both arrays destroy their remaining elements
+	EXPECT_EQ(data.dtor_counter, 12);
+}
+
+TEST(static_swap_back_array, at)
+{
+	stc::static_swap_back_array<int, 4> ssba = {1, 2};
+
+	EXPECT_EQ(ssba.at(1), 2);
+	EXPECT_THROW((void)ssba.at(2), std::out_of_range);
+}
+
+TEST(static_swap_back_array, capacity_exceeded)
+{
+	stc::static_swap_back_array<int, 4> ssba = {1, 2, 3, 4};
+
+	// asserts in debug builds, throws instead of writing past the storage when assertions are disabled
+#ifdef NDEBUG
+	EXPECT_THROW(ssba.push_back(5), std::length_error);
+	EXPECT_THROW(ssba.resize(5), std::length_error);
+	EXPECT_THROW((stc::static_swap_back_array<int, 4>{1, 2, 3, 4, 5}), std::length_error);
+#else
+	EXPECT_DEATH(ssba.push_back(5), "capacity exceeded");
+	EXPECT_DEATH(ssba.resize(5), "capacity exceeded");
+	EXPECT_DEATH((stc::static_swap_back_array<int, 4>{1, 2, 3, 4, 5}), "capacity exceeded");
+#endif
+	EXPECT_EQ(ssba.size(), 4);
+}
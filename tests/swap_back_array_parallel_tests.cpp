@@ -0,0 +1,101 @@
+#include "stc/swap_back_array_parallel.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+TEST(swap_back_array_parallel, erase_if_parallel)
+{
+	// large enough for every thread to get a chunk
+	constexpr size_t size = 1'000'003;
+	stc::swap_back_array<size_t> source(size);
+	for (size_t i = 0; i < size; ++i)
+		source[i] = (i * 2654435761u) % size;
+
+	auto none = [](size_t) { return false; };
+	auto few = [](size_t value) { return value % 1000 == 0; };
+	auto half = [](size_t value) { return value % 2 == 0; };
+	auto most = [](size_t value) { return value % 100 != 0; };
+	auto front = [](size_t value) { return value < size / 3; };
+	auto all = [](size_t) { return true; };
+
+	auto check = [&](auto pred)
+	{
+		auto serial = source;
+		auto serial_removed = serial.erase_swap_if(pred);
+
+		for (unsigned thread_count : {1u, 2u, 3u, 8u})
+		{
+			auto parallel = source;
+			auto parallel_removed = stc::erase_swap_if_parallel(parallel, pred, thread_count);
+
+			// same pairing of holes and survivors as the serial path
+			EXPECT_EQ(parallel_removed, serial_removed);
+			EXPECT_EQ(parallel, serial);
+		}
+	};
+
+	check(none);
+	check(few);
+	check(half);
+	check(most);
+	check(front);
+	check(all);
+}
+
+TEST(swap_back_array_parallel, erase_if_parallel_lifetime)
+{
+	// shared_ptr counts its owners atomically, unlike test_element
+	struct tracked
+	{
+		size_t id;
+		std::shared_ptr<int> token;
+	};
+
+	auto token = std::make_shared<int>();
+	stc::swap_back_array<tracked> sba;
+	for (size_t i = 0; i < 300'000; ++i)
+		sba.push_back({i, token});
+
+	auto removed = stc::erase_swap_if_parallel(sba, [](const tracked& t) { return t.id % 3 == 0; }, 4);
+
+	// removed elements are destroyed, moved ones are not duplicated
+	EXPECT_EQ(removed, 100'000);
+	EXPECT_EQ(sba.size(), 200'000);
+	EXPECT_EQ(token.use_count(), 200'001);
+	for (auto& t : sba)
+		EXPECT_NE(t.id % 3, 0);
+}
+
+TEST(swap_back_array_parallel, erase_if_parallel_throwing_predicate)
+{
+	// the workers are running when the calling thread throws, so the death test must re-execute the binary
+	GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+	stc::swap_back_array<size_t> sba(200'000);
+	for (size_t i = 0; i < sba.size(); ++i)
+		sba[i] = i;
+
+	// element 0 is in the chunk of the calling thread, the last one in the chunk of a worker
+	auto throw_on = [&](size_t target)
+	{
+		return [=](size_t value) -> bool
+		{
+			if (value == target)
+				throw 0;
+			return false;
+		};
+	};
+	EXPECT_DEATH(stc::erase_swap_if_parallel(sba, throw_on(0), 2), "");
+	EXPECT_DEATH(stc::erase_swap_if_parallel(sba, throw_on(sba.size() - 1), 2), "");
+}
+
+TEST(swap_back_array_parallel, erase_if_parallel_default_threads)
+{
+	stc::swap_back_array<size_t> sba(200'000);
+	for (size_t i = 0; i < sba.size(); ++i)
+		sba[i] = i;
+
+	EXPECT_EQ(stc::erase_swap_if_parallel(sba, [](size_t value) { return value % 4 == 0; }), 50'000);
+	EXPECT_EQ(sba.size(), 150'000);
+	for (auto value : sba)
+		EXPECT_NE(value % 4, 0);
+}
@@ -1,6 +1,11 @@
 #include "stc/swap_back_array.h"
 #include "test_element.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace
 {
@@ -28,6 +33,25 @@ bool find_test_element_by_id(const stc::swap_back_array<test_element>& sba, size
 	return false;
 }
 
+// Move-only, with a move constructor throwing once moves_before_throw moves are done, if it is not negative.
+struct throwing_move_only
+{
+	static inline int moves_before_throw = -1;
+
+	explicit throwing_move_only(int value) : value(value) {}
+	throwing_move_only(throwing_move_only&& other) : value(other.value)
+	{
+		if (moves_before_throw == 0)
+			throw std::runtime_error("move");
+		if (moves_before_throw > 0)
+			--moves_before_throw;
+		other.value = -1;
+	}
+	throwing_move_only& operator=(throwing_move_only&& other) noexcept = default;
+
+	int value;
+};
+
 } // namespace
 
 TEST(swap_back_array, erase_index)
@@ -532,3 +556,335 @@ TEST(swap_back_array, erase_iterator_range_at_end)
 	EXPECT_EQ(data.dtor_counter, 15);
 	EXPECT_EQ(data.move_counter, 0);
 }
+
+TEST(swap_back_array, erase_if)
+{
+	test_element_data data;
+	auto sba = test_sba(10, data);
+
+	auto removed = sba.erase_swap_if([](const test_element& te) { return te.id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(sba.size(), 5);
+	for (size_t id = 0; id < 10; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(sba, id), id % 2 != 0);
+	}
+	EXPECT_EQ(data.ctor_counter, 10);
+	EXPECT_EQ(data.copy_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 5);
+	EXPECT_EQ(data.move_counter, 3);
+
+	removed = sba.erase_swap_if([](const test_element&) { return false; });
+
+	EXPECT_EQ(removed, 0);
+	EXPECT_EQ(sba.size(), 5);
+	EXPECT_EQ(data.dtor_counter, 5);
+	EXPECT_EQ(data.move_counter, 3);
+
+	removed = sba.erase_swap_if([](const test_element&) { return true; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(sba.size(), 0);
+	EXPECT_EQ(data.dtor_counter, 10);
+	EXPECT_EQ(data.move_counter, 3);
+}
+
+TEST(swap_back_array, erase_if_range)
+{
+	test_element_data data;
+	auto sba = test_sba(30, data);
+	size_t tested = 0;
+
+	auto removed = sba.erase_swap_if(sba.begin() + 5, sba.begin() + 15, [&](const test_element& te)
+	{
+		++tested;
+		return te.id % 2 == 0;
+	});
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(tested, 10);
+	EXPECT_EQ(sba.size(), 25);
+	for (size_t id = 0; id < 30; ++id)
+	{
+		bool in_range = 5 <= id && id < 15;
+		EXPECT_EQ(find_test_element_by_id(sba, id), !in_range || id % 2 != 0);
+	}
+	EXPECT_EQ(data.ctor_counter, 30);
+	EXPECT_EQ(data.copy_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 5);
+
+	removed = sba.erase_swap_if(sba.end() - 5, sba.end(), [](const test_element&) { return true; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(sba.size(), 20);
+	EXPECT_EQ(data.dtor_counter, 10);
+}
+
+TEST(swap_back_array, erase_indices_sorted)
+{
+	test_element_data data;
+	auto sba = test_sba(1000, data);
+
+	// duplicated, unordered, and including the last elements which would be moved by erase_swap
+	std::vector<size_t> indices = {999, 2, 500, 2, 998};
+	auto removed = sba.erase_swap_indices(indices);
+
+	EXPECT_EQ(removed, 4);
+	EXPECT_EQ(sba.size(), 996);
+	for (size_t id : {2, 500, 998, 999})
+	{
+		EXPECT_FALSE(find_test_element_by_id(sba, id));
+	}
+	for (size_t id : {0, 1, 3, 499, 501, 996, 997})
+	{
+		EXPECT_TRUE(find_test_element_by_id(sba, id));
+	}
+	EXPECT_EQ(data.ctor_counter, 1000);
+	EXPECT_EQ(data.copy_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 4);
+	EXPECT_EQ(data.move_counter, 2);
+}
+
+TEST(swap_back_array, erase_indices_marked)
+{
+	test_element_data data;
+	auto sba = test_sba(200, data);
+
+	// every index from 50 to 149, in descending order, plus duplicates
+	std::vector<size_t> indices;
+	for (size_t i = 150; i-- > 50;)
+		indices.push_back(i);
+	indices.push_back(50);
+	indices.push_back(149);
+
+	auto removed = sba.erase_swap_indices(indices);
+
+	EXPECT_EQ(removed, 100);
+	EXPECT_EQ(sba.size(), 100);
+	for (size_t id = 0; id < 200; ++id)
+	{
+		EXPECT_EQ(find_test_element_by_id(sba, id), id < 50 || id >= 150);
+	}
+	EXPECT_EQ(data.dtor_counter, 100);
+	EXPECT_EQ(data.move_counter, 50);
+
+	EXPECT_EQ(sba.erase_swap_indices({}), 0);
+	EXPECT_EQ(sba.size(), 100);
+}
+
+TEST(swap_back_array, erase_indices_strategies_agree)
+{
+	stc::swap_back_array<size_t> values(1000);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = i;
+
+	// same deletions through both strategies, removed one batch at a time
+	std::vector<size_t> indices;
+	for (size_t i = 0; i < 1000; i += 7)
+		indices.push_back(i);
+
+	auto by_mark = values;
+	by_mark.erase_swap_indices(indices);
+
+	auto by_sort = values;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		std::vector<size_t> batch;
+		for (size_t j = i; j < std::min(i + 3, indices.size()); ++j)
+			batch.push_back(std::find(by_sort.begin(), by_sort.end(), indices[j]) - by_sort.begin());
+		by_sort.erase_swap_indices(batch);
+	}
+
+	std::sort(by_mark.begin(), by_mark.end());
+	std::sort(by_sort.begin(), by_sort.end());
+	EXPECT_EQ(by_mark, by_sort);
+	EXPECT_EQ(by_mark.size(), 1000 - indices.size());
+}
+
+TEST(swap_back_array, erase_tracked)
+{
+	stc::swap_back_array<size_t> values = {0, 1, 2, 3, 4};
+
+	auto moved = values.erase_swap_tracked(1);
+	ASSERT_TRUE(moved.has_value());
+	EXPECT_EQ(*moved, (stc::relocation{4, 1}));
+	EXPECT_EQ(values[1], 4);
+
+	// removing the last element moves nothing
+	EXPECT_FALSE(values.erase_swap_tracked(3).has_value());
+	EXPECT_EQ(values.size(), 3);
+}
+
+TEST(swap_back_array, erase_range_tracked)
+{
+	stc::swap_back_array<size_t> values(10);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = i;
+
+	stc::relocation buffer[4];
+	auto end = values.erase_swap_tracked(2, 4, buffer);
+	ASSERT_EQ(end - buffer, 4);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(buffer[i], (stc::relocation{6 + i, 2 + i}));
+		EXPECT_EQ(values[2 + i], 6 + i);
+	}
+
+	// the range overlaps the moved tail: only the elements below the new size move
+	end = values.erase_swap_tracked(3, 2, buffer);
+	ASSERT_EQ(end - buffer, 1);
+	EXPECT_EQ(buffer[0], (stc::relocation{5, 3}));
+	EXPECT_EQ(values.size(), 4);
+
+	end = values.erase_swap_tracked(2, 2, buffer);
+	EXPECT_EQ(end - buffer, 0);
+}
+
+TEST(swap_back_array, erase_indices_tracked)
+{
+	// an external table holding the index of each value, kept up to date with the records
+	for (size_t batch : {5, 300})
+	{
+		stc::swap_back_array<size_t> values(1000);
+		std::vector<size_t> index_of(values.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			values[i] = index_of[i] = i;
+
+		std::vector<size_t> indices;
+		for (size_t i = 0; i < batch; ++i)
+			indices.push_back((i * 7919) % values.size());
+
+		std::vector<stc::relocation> moves;
+		values.erase_swap_indices_tracked(indices, std::back_inserter(moves));
+		EXPECT_LE(moves.size(), indices.size());
+
+		for (auto [from, to] : moves)
+		{
+			EXPECT_EQ(index_of[values[to]], from);
+			index_of[values[to]] = to;
+		}
+		for (size_t i = 0; i < values.size(); ++i)
+			EXPECT_EQ(index_of[values[i]], i);
+	}
+}
+
+TEST(swap_back_array, shrink_policy)
+{
+	using policy = stc::shrink_by_half<4, 16>;
+	static_assert(policy::shrunk_capacity(100, 256) == 256);
+	static_assert(policy::shrunk_capacity(63, 256) == 128);
+	static_assert(policy::shrunk_capacity(1, 256) == 16);
+	static_assert(policy::shrunk_capacity(0, 8) == 8);
+	static_assert(stc::never_shrink::shrunk_capacity(0, 256) == 256);
+
+	// the default keeps the capacity
+	stc::swap_back_array<int> kept(1024);
+	kept.erase_swap(0, 1020);
+	EXPECT_EQ(kept.capacity(), 1024);
+
+	stc::swap_back_array<int, std::allocator<int>, policy> sba;
+	sba.reserve(1024);
+	for (int i = 0; i < 1024; ++i)
+		sba.push_back(i);
+
+	// below a quarter, halved as many times as needed
+	sba.erase_swap(0, 700);
+	EXPECT_EQ(sba.capacity(), 1024);
+	sba.erase_swap(0, 101);
+	EXPECT_EQ(sba.size(), 223);
+	EXPECT_EQ(sba.capacity(), 512);
+	std::vector<int> sorted(sba.begin(), sba.end());
+	std::sort(sorted.begin(), sorted.end());
+	for (int i = 0; i < 223; ++i)
+		EXPECT_EQ(sorted[i], i + 801);
+
+	// hysteresis: growing back to the shrink threshold does not reallocate
+	while (sba.size() < 400)
+		sba.push_back(-1);
+	EXPECT_EQ(sba.capacity(), 512);
+
+	// returned iterators stay valid across reallocations
+	for (auto it = sba.begin(); it != sba.end();)
+	{
+		if (*it >= 0)
+			it = sba.erase_swap(it);
+		else
+			++it;
+	}
+	EXPECT_EQ(sba.size(), 177);
+	EXPECT_EQ(sba.capacity(), 512);
+	EXPECT_EQ(sba.erase_swap_if([](int v) { return v == -1; }), 177);
+	EXPECT_EQ(sba.capacity(), 16);
+}
+
+TEST(swap_back_array, shrink_policy_lifetime)
+{
+	test_element_data data;
+	{
+		stc::swap_back_array<test_element, std::allocator<test_element>, stc::shrink_by_half<>> sba;
+		sba.reserve(1000);
+		for (size_t i = 0; i < 1000; ++i)
+			sba.emplace_back(i, data);
+
+		sba.erase_swap(0, 900);
+		EXPECT_EQ(sba.capacity(), 250);
+		for (size_t i = 0; i < 100; ++i)
+			EXPECT_EQ(sba[i].id, i + 900);
+
+		std::vector<size_t> indices = {0, 1, 2, 3, 4};
+		sba.erase_swap_indices(indices);
+		EXPECT_EQ(sba.size(), 95);
+		EXPECT_EQ(sba.capacity(), 250);
+	}
+	// the 100 survivors were moved once into the shrunk buffer, never copied
+	EXPECT_EQ(data.ctor_counter, 1000);
+	EXPECT_EQ(data.copy_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 1100);
+}
+
+TEST(swap_back_array, shrink_policy_throwing_move_only)
+{
+	stc::swap_back_array<throwing_move_only, std::allocator<throwing_move_only>, stc::shrink_by_half<4, 16>> sba;
+	sba.reserve(256);
+	for (int i = 0; i < 256; ++i)
+		sba.emplace_back(i);
+
+	// reallocating could lose the elements moved before the throw, so the capacity is kept
+	throwing_move_only::moves_before_throw = 5;
+	sba.erase_swap(0, 240);
+	throwing_move_only::moves_before_throw = -1;
+	EXPECT_EQ(sba.capacity(), 256);
+	ASSERT_EQ(sba.size(), 16);
+	for (int i = 0; i < 16; ++i)
+		EXPECT_EQ(sba[i].value, i + 240);
+}
+
+TEST(swap_back_array, find_and_erase_value)
+{
+	stc::swap_back_array<std::uint32_t> ids;
+	for (std::uint32_t i = 0; i < 1000; ++i)
+		ids.push_back(i % 100);
+
+	EXPECT_EQ(ids.find_swap(42) - ids.begin(), 42);
+	EXPECT_EQ(ids.find_swap(1000), ids.end());
+	EXPECT_EQ(std::as_const(ids).find_swap(99) - ids.cbegin(), 99);
+
+	EXPECT_TRUE(ids.erase_swap_value(42));
+	EXPECT_EQ(ids.size(), 999);
+	EXPECT_EQ(ids[42], 99);
+	EXPECT_FALSE(ids.erase_swap_value(1000));
+
+	// same result as the predicate version
+	auto expected = ids;
+	auto expected_removed = expected.erase_swap_if([](std::uint32_t id) { return id == 7; });
+	EXPECT_EQ(ids.erase_swap_all(7), expected_removed);
+	EXPECT_EQ(ids, expected);
+	EXPECT_EQ(ids.erase_swap_all(7), 0);
+
+	// types without a vectorized kernel
+	stc::swap_back_array<std::string> names = {"a", "b", "a", "c"};
+	EXPECT_EQ(names.find_swap("c") - names.begin(), 3);
+	EXPECT_EQ(names.erase_swap_all("a"), 2);
+	EXPECT_EQ(names, (stc::swap_back_array<std::string>{"c", "b"}));
+}
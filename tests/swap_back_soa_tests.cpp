@@ -0,0 +1,136 @@
+#include "stc/swap_back_soa.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// Column 0 holds the id, column 1 a tracked element with the same id.
+using test_soa = stc::swap_back_soa<size_t, test_element>;
+
+test_soa make_test_soa(size_t count, test_element_data& data)
+{
+	test_soa soa;
+	soa.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		soa.emplace_back(i, test_element(i, data));
+	}
+	return soa;
+}
+
+bool columns_in_sync(const test_soa& soa)
+{
+	for (size_t i = 0; i < soa.size(); ++i)
+	{
+		if (soa.column<0>()[i] != soa.column<1>()[i].id)
+			return false;
+	}
+	return true;
+}
+
+bool find_id(const test_soa& soa, size_t id)
+{
+	for (size_t value : soa.column<0>())
+	{
+		if (value == id)
+			return true;
+	}
+	return false;
+}
+
+} // namespace
+
+TEST(swap_back_soa, emplace_back)
+{
+	test_element_data data;
+	auto soa = make_test_soa(10, data);
+
+	EXPECT_EQ(soa.size(), 10);
+	EXPECT_EQ(soa.column<0>().size(), 10);
+	EXPECT_EQ(soa.column<1>().size(), 10);
+	EXPECT_TRUE(columns_in_sync(soa));
+
+	auto [id, element] = soa.row(3);
+	EXPECT_EQ(id, 3);
+	EXPECT_EQ(element.id, 3);
+	EXPECT_EQ(data.copy_counter, 0);
+}
+
+TEST(swap_back_soa, erase_index)
+{
+	test_element_data data;
+	auto soa = make_test_soa(10, data);
+	data = {};
+
+	soa.erase_swap(2);
+	soa.erase_swap(soa.size() - 1);
+	soa.erase_swap(0);
+
+	EXPECT_EQ(soa.size(), 7);
+	EXPECT_FALSE(find_id(soa, 2));
+	EXPECT_FALSE(find_id(soa, 8));
+	EXPECT_FALSE(find_id(soa, 0));
+	EXPECT_TRUE(columns_in_sync(soa));
+	EXPECT_EQ(data.dtor_counter, 3);
+	EXPECT_EQ(data.move_counter, 2);
+}
+
+TEST(swap_back_soa, erase_index_range)
+{
+	test_element_data data;
+	auto soa = make_test_soa(30, data);
+	data = {};
+
+	soa.erase_swap(2, 4);
+	EXPECT_EQ(soa.size(), 26);
+	for (size_t id = 2; id < 6; ++id)
+	{
+		EXPECT_FALSE(find_id(soa, id));
+	}
+	EXPECT_TRUE(columns_in_sync(soa));
+	EXPECT_EQ(data.dtor_counter, 4);
+	EXPECT_EQ(data.move_counter, 4);
+
+	soa.erase_swap(20, 6);
+	EXPECT_EQ(soa.size(), 20);
+	EXPECT_TRUE(columns_in_sync(soa));
+	EXPECT_EQ(data.dtor_counter, 10);
+	EXPECT_EQ(data.move_counter, 4);
+}
+
+TEST(swap_back_soa, erase_if)
+{
+	test_element_data data;
+	auto soa = make_test_soa(10, data);
+	data = {};
+
+	auto removed = soa.erase_swap_if([](size_t id, test_element&) { return id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(soa.size(), 5);
+	for (size_t id = 0; id < 10; ++id)
+	{
+		EXPECT_EQ(find_id(soa, id), id % 2 != 0);
+	}
+	EXPECT_TRUE(columns_in_sync(soa));
+	EXPECT_EQ(data.dtor_counter, 5);
+	EXPECT_EQ(data.move_counter, 3);
+}
+
+TEST(swap_back_soa, erase_if_range)
+{
+	test_element_data data;
+	auto soa = make_test_soa(30, data);
+
+	auto removed = soa.erase_swap_if(5, 10, [](size_t id, test_element&) { return id % 2 == 0; });
+
+	EXPECT_EQ(removed, 5);
+	EXPECT_EQ(soa.size(), 25);
+	for (size_t id = 0; id < 30; ++id)
+	{
+		bool in_range = 5 <= id && id < 15;
+		EXPECT_EQ(find_id(soa, id), !in_range || id % 2 != 0);
+	}
+	EXPECT_TRUE(columns_in_sync(soa));
+}
@@ -0,0 +1,176 @@
+#include "stc/concurrent_swap_back_array.h"
+#include "stc/small_swap_back_array.h"
+#include "stc/swap_back_array.h"
+#include "stc/trivially_relocatable.h"
+#include "test_element.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+
+// Counts moves like test_element, but opts in to trivial relocation.
+struct relocatable_element : test_element
+{
+	using test_element::test_element;
+};
+
+struct pod_element
+{
+	size_t id;
+	char payload[56];
+};
+
+// Resizes buffers through allocate + memcpy, counting the calls.
+template <typename T>
+struct reallocating_allocator : std::allocator<T>
+{
+	using value_type = T;
+
+	inline static size_t reallocations = 0;
+
+	reallocating_allocator() = default;
+	template <typename U>
+	reallocating_allocator(const reallocating_allocator<U>&) noexcept {}
+
+	template <typename U>
+	struct rebind { using other = reallocating_allocator<U>; };
+
+	T* reallocate(T* ptr, size_t old_count, size_t new_count)
+	{
+		++reallocations;
+		T* new_ptr = this->allocate(new_count);
+		std::memcpy(static_cast<void*>(new_ptr), static_cast<void*>(ptr), std::min(old_count, new_count) * sizeof(T));
+		this->deallocate(ptr, old_count);
+		return new_ptr;
+	}
+};
+
+} // namespace
+
+template <>
+struct stc::is_trivially_relocatable<relocatable_element> : std::true_type {};
+
+static_assert(stc::is_trivially_relocatable_v<int>);
+static_assert(stc::is_trivially_relocatable_v<pod_element>);
+static_assert(!stc::is_trivially_relocatable_v<test_element>);
+static_assert(!stc::is_trivially_relocatable_v<std::string>);
+static_assert(stc::is_trivially_relocatable_v<relocatable_element>);
+static_assert(stc::reallocating_allocator<reallocating_allocator<int>>);
+static_assert(!stc::reallocating_allocator<std::allocator<int>>);
+
+TEST(trivially_relocatable, swap_back_array_erase_range)
+{
+	test_element_data data;
+	stc::swap_back_array<relocatable_element> sba;
+	sba.reserve(30);
+	for (size_t i = 0; i < 30; ++i)
+		sba.emplace_back(i, data);
+
+	sba.erase_swap(2, 4);
+
+	// relocated with memcpy, no move operation is called, removed elements are destroyed once
+	EXPECT_EQ(sba.size(), 26);
+	EXPECT_EQ(data.move_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 4);
+	for (size_t i = 0; i < 2; ++i)
+		EXPECT_EQ(sba[i].id, i);
+	for (size_t i = 2; i < 6; ++i)
+		EXPECT_EQ(sba[i].id, i + 24);
+
+	sba.erase_swap(sba.begin() + 20, sba.begin() + 25);
+	EXPECT_EQ(sba.size(), 21);
+	EXPECT_EQ(data.move_counter, 0);
+	EXPECT_EQ(data.dtor_counter, 9);
+}
+
+TEST(trivially_relocatable, swap_back_array_erase_range_pod)
+{
+	stc::swap_back_array<pod_element> sba(10);
+	for (size_t i = 0; i < sba.size(); ++i)
+		sba[i].id = i;
+
+	sba.erase_swap(1, 3);
+
+	ASSERT_EQ(sba.size(), 7);
+	size_t expected[] = {0, 7, 8, 9, 4, 5, 6};
+	for (size_t i = 0; i < sba.size(); ++i)
+		EXPECT_EQ(sba[i].id, expected[i]);
+}
+
+TEST(trivially_relocatable, small_swap_back_array_growth)
+{
+	test_element_data data;
+	{
+		stc::small_swap_back_array<relocatable_element, 4> ssba;
+		for (size_t i = 0; i < 20; ++i)
+			ssba.emplace_back(i, data);
+
+		EXPECT_FALSE(ssba.is_inline());
+		EXPECT_EQ(data.move_counter, 0);
+		EXPECT_EQ(data.dtor_counter, 0);
+
+		ssba.erase_swap(ssba.begin() + 3, ssba.begin() + 8);
+		EXPECT_EQ(ssba.size(), 15);
+		EXPECT_EQ(data.move_counter, 0);
+		EXPECT_EQ(data.dtor_counter, 5);
+		for (size_t i = 3; i < 8; ++i)
+			EXPECT_EQ(ssba[i].id, i + 12);
+
+		ssba.erase_swap(0, 12);
+		ssba.shrink_to_fit();
+		EXPECT_TRUE(ssba.is_inline());
+		EXPECT_EQ(ssba.size(), 3);
+		EXPECT_EQ(data.move_counter, 0);
+	}
+	EXPECT_EQ(data.dtor_counter, 20);
+}
+
+TEST(trivially_relocatable, reallocating_allocator)
+{
+	using allocator = reallocating_allocator<pod_element>;
+	allocator::reallocations = 0;
+
+	stc::small_swap_back_array<pod_element, 4, allocator> ssba;
+	for (size_t i = 0; i < 64; ++i)
+		ssba.push_back({i, {}});
+
+	// inline to heap allocates, heap to heap reallocates: 8, 16, 32, 64
+	EXPECT_EQ(allocator::reallocations, 3);
+	for (size_t i = 0; i < 64; ++i)
+		EXPECT_EQ(ssba[i].id, i);
+
+	// args referring to an element survive the reallocation
+	ssba.push_back(ssba[10]);
+	EXPECT_EQ(allocator::reallocations, 4);
+	EXPECT_EQ(ssba.back().id, 10);
+
+	ssba.erase_swap(0, 40);
+	ssba.shrink_to_fit();
+	EXPECT_EQ(allocator::reallocations, 5);
+	EXPECT_EQ(ssba.capacity(), 25);
+	EXPECT_EQ(ssba[0].id, 40);
+
+	stc::concurrent_swap_back_array<pod_element, allocator> csba(8);
+	for (size_t i = 0; i < 8; ++i)
+		(void)csba.try_push_back(pod_element{i, {}});
+	csba.reserve(16);
+	EXPECT_EQ(allocator::reallocations, 6);
+	EXPECT_EQ(csba.size(), 8);
+	EXPECT_EQ(csba[7].id, 7);
+}
+
+TEST(trivially_relocatable, reallocating_allocator_lifetime)
+{
+	test_element_data data;
+	{
+		stc::small_swap_back_array<relocatable_element, 2, reallocating_allocator<relocatable_element>> ssba;
+		for (size_t i = 0; i < 20; ++i)
+			ssba.emplace_back(i, data);
+		for (size_t i = 0; i < 20; ++i)
+			EXPECT_EQ(ssba[i].id, i);
+	}
+	EXPECT_EQ(data.ctor_counter + data.copy_counter + data.move_counter, data.dtor_counter);
+}